@@ -1,7 +1,10 @@
 #include "LayoutAnimationsManager.h"
 #include "CollectionUtils.h"
+#include "GlobalFunctionHandles.h"
 #include "Shareables.h"
 
+#include <stdexcept>
+
 #ifndef NDEBUG
 #include <utility>
 #endif
@@ -105,15 +108,13 @@ void LayoutAnimationsManager::startLayoutAnimation(
     auto lock = std::unique_lock<std::mutex>(animationsMutex_);
     config = getConfigsForType(type)[tag];
   }
-  // TODO: cache the following!!
-  jsi::Value layoutAnimationRepositoryAsValue =
-      rt.global()
-          .getPropertyAsObject(rt, "global")
-          .getProperty(rt, "LayoutAnimationsManager");
-  jsi::Function startAnimationForTag =
-      layoutAnimationRepositoryAsValue.getObject(rt).getPropertyAsFunction(
-          rt, "start");
-  startAnimationForTag.call(
+  auto startAnimationForTag =
+      GlobalFunctionHandles::get(rt, GlobalFunction::LayoutAnimationsStart);
+  if (startAnimationForTag == nullptr) {
+    throw std::runtime_error(
+        "[Reanimated] `LayoutAnimationsManager.start` not found.");
+  }
+  startAnimationForTag->call(
       rt,
       jsi::Value(tag),
       jsi::Value(static_cast<int>(type)),
@@ -124,14 +125,13 @@ void LayoutAnimationsManager::startLayoutAnimation(
 void LayoutAnimationsManager::cancelLayoutAnimation(
     jsi::Runtime &rt,
     const int tag) const {
-  jsi::Value layoutAnimationRepositoryAsValue =
-      rt.global()
-          .getPropertyAsObject(rt, "global")
-          .getProperty(rt, "LayoutAnimationsManager");
-  jsi::Function cancelLayoutAnimation =
-      layoutAnimationRepositoryAsValue.getObject(rt).getPropertyAsFunction(
-          rt, "stop");
-  cancelLayoutAnimation.call(rt, jsi::Value(tag));
+  auto cancelLayoutAnimation =
+      GlobalFunctionHandles::get(rt, GlobalFunction::LayoutAnimationsStop);
+  if (cancelLayoutAnimation == nullptr) {
+    throw std::runtime_error(
+        "[Reanimated] `LayoutAnimationsManager.stop` not found.");
+  }
+  cancelLayoutAnimation->call(rt, jsi::Value(tag));
 }
 
 /*
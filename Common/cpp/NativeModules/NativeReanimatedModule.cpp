@@ -11,7 +11,11 @@
 #endif
 #endif
 
+#include <chrono>
+#include <cmath>
 #include <functional>
+#include <iterator>
+#include <limits>
 #include <memory>
 #include <thread>
 #include <unordered_map>
@@ -25,11 +29,13 @@
 #include "CollectionUtils.h"
 #include "EventHandlerRegistry.h"
 #include "FeaturesConfig.h"
+#include "GlobalFunctionHandles.h"
 #include "JSScheduler.h"
 #include "ReanimatedHiddenHeaders.h"
 #include "Shareables.h"
 #include "UIRuntimeDecorator.h"
 #include "WorkletEventHandler.h"
+#include "WorkletRuntimePool.h"
 
 #ifdef __ANDROID__
 #include <fbjni/fbjni.h>
@@ -55,13 +61,6 @@ NativeReanimatedModule::NativeReanimatedModule(
       jsQueue_(jsQueue),
       jsScheduler_(std::make_shared<JSScheduler>(rnRuntime, jsInvoker)),
       uiScheduler_(uiScheduler),
-      uiWorkletRuntime_(std::make_shared<WorkletRuntime>(
-          rnRuntime,
-          jsQueue,
-          jsScheduler_,
-          "Reanimated UI runtime",
-          true /* supportsLocking */,
-          valueUnpackerCode)),
       valueUnpackerCode_(valueUnpackerCode),
       eventHandlerRegistry_(std::make_unique<EventHandlerRegistry>()),
       requestRender_(platformDepMethodsHolder.requestRender),
@@ -91,6 +90,11 @@ NativeReanimatedModule::NativeReanimatedModule(
         this->requestAnimationFrame(rt, callback);
       };
 
+  auto requestDeferrableAnimationFrame =
+      [this](jsi::Runtime &rt, const jsi::Value &callback) {
+        this->requestDeferrableAnimationFrame(rt, callback);
+      };
+
 #ifdef RCT_NEW_ARCH_ENABLED
   auto updateProps = [this](jsi::Runtime &rt, const jsi::Value &operations) {
     this->updateProps(rt, operations);
@@ -114,90 +118,568 @@ NativeReanimatedModule::NativeReanimatedModule(
   };
 #endif
 
-  jsi::Runtime &uiRuntime = uiWorkletRuntime_->getJSIRuntime();
-  UIRuntimeDecorator::decorate(
-      uiRuntime,
+  auto decorateUIRuntime = [=](jsi::Runtime &uiRuntime) {
+    UIRuntimeDecorator::decorate(
+        uiRuntime,
 #ifdef RCT_NEW_ARCH_ENABLED
-      removeFromPropsRegistry,
-      updateProps,
-      measure,
-      dispatchCommand,
+        removeFromPropsRegistry,
+        updateProps,
+        measure,
+        dispatchCommand,
 #else
-      platformDepMethodsHolder.scrollToFunction,
-      platformDepMethodsHolder.updatePropsFunction,
-      platformDepMethodsHolder.measureFunction,
-      platformDepMethodsHolder.dispatchCommandFunction,
+        platformDepMethodsHolder.scrollToFunction,
+        platformDepMethodsHolder.updatePropsFunction,
+        platformDepMethodsHolder.measureFunction,
+        platformDepMethodsHolder.dispatchCommandFunction,
 #endif
-      requestAnimationFrame,
-      platformDepMethodsHolder.getAnimationTimestamp,
-      platformDepMethodsHolder.setGestureStateFunction,
-      platformDepMethodsHolder.progressLayoutAnimation,
-      platformDepMethodsHolder.endLayoutAnimation,
-      platformDepMethodsHolder.maybeFlushUIUpdatesQueueFunction);
+        requestAnimationFrame,
+        requestDeferrableAnimationFrame,
+        platformDepMethodsHolder.getAnimationTimestamp,
+        platformDepMethodsHolder.setGestureStateFunction,
+        platformDepMethodsHolder.progressLayoutAnimation,
+        platformDepMethodsHolder.endLayoutAnimation,
+        platformDepMethodsHolder.maybeFlushUIUpdatesQueueFunction);
+  };
+
+#if JS_RUNTIME_V8
+  // V8 worklet runtimes are created from the isolate of the RN runtime, which
+  // can't be used outside of the JS thread.
+  initializeUIRuntime(rnRuntime, jsQueue, decorateUIRuntime);
+  if (uiRuntimeError_ != nullptr) {
+    std::rethrow_exception(uiRuntimeError_);
+  }
+#else
+  // Creating the UI runtime and evaluating the value unpacker takes a while,
+  // so it's done in the background rather than while the app is starting.
+  // Jobs scheduled on the UI runtime in the meantime wait for it in
+  // `pendingUIJobs_`. Frames, events and layout animations on the UI thread are
+  // skipped until it's ready, only calls from the JS thread block on it.
+  uiRuntimeInitThread_ = std::thread([this,
+                                      &rnRuntime,
+                                      jsQueue,
+                                      decorateUIRuntime =
+                                          std::move(decorateUIRuntime)] {
+#ifdef __ANDROID__
+    // the runtime calls into Java, e.g. to quit `jsQueue`
+    jni::ThreadScope::WithClassLoader([&] {
+      initializeUIRuntime(rnRuntime, jsQueue, decorateUIRuntime);
+    });
+#else
+    initializeUIRuntime(rnRuntime, jsQueue, decorateUIRuntime);
+#endif // __ANDROID__
+  });
+#endif // JS_RUNTIME_V8
+}
+
+void NativeReanimatedModule::initializeUIRuntime(
+    jsi::Runtime &rnRuntime,
+    const std::shared_ptr<MessageQueueThread> &jsQueue,
+    const std::function<void(jsi::Runtime &)> &decorateUIRuntime) {
+  std::shared_ptr<WorkletRuntime> uiWorkletRuntime;
+  std::exception_ptr error;
+  try {
+    RuntimeConfig runtimeConfig;
+    runtimeConfig.usePrecompiledWorklets = true;
+    // the UI runtime runs every frame, so short collections matter more than
+    // its footprint
+    runtimeConfig.gcMode = RuntimeGCMode::LowLatency;
+    uiWorkletRuntime = std::make_shared<WorkletRuntime>(
+        rnRuntime,
+        jsQueue,
+        jsScheduler_,
+        "Reanimated UI runtime",
+        true /* supportsLocking */,
+        valueUnpackerCode_,
+        AsyncQueueConfig{},
+        runtimeConfig);
+    decorateUIRuntime(uiWorkletRuntime->getJSIRuntime());
+  } catch (...) {
+    error = std::current_exception();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(uiRuntimeMutex_);
+    if (error != nullptr) {
+      uiRuntimeError_ = error;
+      pendingUIJobs_.clear();
+    } else {
+      uiWorkletRuntime_ = std::move(uiWorkletRuntime);
+      // flushed before the runtime is marked as ready so that they run before
+      // any job scheduled afterwards
+      for (auto &[job, lane] : pendingUIJobs_) {
+        uiScheduler_->scheduleOnUI(std::move(job), lane);
+      }
+      pendingUIJobs_.clear();
+      isUIRuntimeReady_.store(true, std::memory_order_release);
+    }
+  }
+  uiRuntimeCv_.notify_all();
+}
+
+void NativeReanimatedModule::waitForUIRuntime() {
+  std::unique_lock<std::mutex> lock(uiRuntimeMutex_);
+  uiRuntimeCv_.wait(lock, [this] {
+    return isUIRuntimeReady_.load(std::memory_order_relaxed) ||
+        uiRuntimeError_ != nullptr;
+  });
+  if (uiRuntimeError_ != nullptr) {
+    std::rethrow_exception(uiRuntimeError_);
+  }
+}
+
+void NativeReanimatedModule::scheduleOnUIRuntime(UIJob &&job, UILane lane) {
+  if (!isUIRuntimeReady_.load(std::memory_order_acquire)) {
+    std::lock_guard<std::mutex> lock(uiRuntimeMutex_);
+    if (uiRuntimeError_ != nullptr) {
+      std::rethrow_exception(uiRuntimeError_);
+    }
+    if (!isUIRuntimeReady_.load(std::memory_order_relaxed)) {
+      pendingUIJobs_.emplace_back(std::move(job), lane);
+      return;
+    }
+  }
+  uiScheduler_->scheduleOnUI(std::move(job), lane);
 }
 
 NativeReanimatedModule::~NativeReanimatedModule() {
+  if (uiRuntimeInitThread_.joinable()) {
+    uiRuntimeInitThread_.join();
+  }
   // event handler registry and frame callbacks store some JSI values from UI
   // runtime, so they have to go away before we tear down the runtime
   eventHandlerRegistry_.reset();
   frameCallbacks_.clear();
+  deferrableFrameCallbacks_.clear();
   uiWorkletRuntime_.reset();
 }
 
+static UILane parseUILane(jsi::Runtime &rt, const jsi::Value &lane) {
+  if (lane.isUndefined()) {
+    return UILane::Urgent;
+  }
+  if (lane.isString()) {
+    auto laneStr = lane.asString(rt).utf8(rt);
+    if (laneStr == "urgent") {
+      return UILane::Urgent;
+    } else if (laneStr == "deferrable") {
+      return UILane::Deferrable;
+    }
+  }
+  throw std::runtime_error(
+      "[Reanimated] UI lane must be either 'urgent' or 'deferrable'.");
+}
+
 void NativeReanimatedModule::scheduleOnUI(
     jsi::Runtime &rt,
-    const jsi::Value &worklet) {
+    const jsi::Value &worklet,
+    const jsi::Value &lane) {
   auto shareableWorklet = extractShareableOrThrow<ShareableWorklet>(
       rt, worklet, "[Reanimated] Only worklets can be scheduled to run on UI.");
-  uiScheduler_->scheduleOnUI([=] {
+  auto job = [=] {
 #if JS_RUNTIME_HERMES
     // JSI's scope defined here allows for JSI-objects to be cleared up after
     // each runtime loop. Within these loops we typically create some temporary
     // JSI objects and hence it allows for such objects to be garbage collected
     // much sooner.
     // Apparently the scope API is only supported on Hermes at the moment.
-    const auto scope = jsi::Scope(uiWorkletRuntime_->getJSIRuntime());
+    const auto scope = jsi::Scope(getUIRuntime());
 #endif
-    uiWorkletRuntime_->runGuarded(shareableWorklet);
-  });
+    getUIWorkletRuntime()->runGuarded(shareableWorklet);
+  };
+  scheduleOnUIRuntime(std::move(job), parseUILane(rt, lane));
+}
+
+enum class ExecuteSyncTimeoutBehavior {
+  Throw,
+  Skip,
+  Async,
+};
+
+static ExecuteSyncTimeoutBehavior parseExecuteSyncTimeoutBehavior(
+    jsi::Runtime &rt,
+    const jsi::Value &onTimeout) {
+  if (onTimeout.isUndefined()) {
+    return ExecuteSyncTimeoutBehavior::Throw;
+  }
+  if (onTimeout.isString()) {
+    auto onTimeoutStr = onTimeout.asString(rt).utf8(rt);
+    if (onTimeoutStr == "throw") {
+      return ExecuteSyncTimeoutBehavior::Throw;
+    } else if (onTimeoutStr == "skip") {
+      return ExecuteSyncTimeoutBehavior::Skip;
+    } else if (onTimeoutStr == "async") {
+      return ExecuteSyncTimeoutBehavior::Async;
+    }
+  }
+  throw std::runtime_error(
+      "[Reanimated] `onTimeout` must be either 'throw', 'skip' or 'async'.");
 }
 
 jsi::Value NativeReanimatedModule::executeOnUIRuntimeSync(
     jsi::Runtime &rt,
-    const jsi::Value &worklet) {
-  return uiWorkletRuntime_->executeSync(rt, worklet);
+    const jsi::Value &worklet,
+    const jsi::Value &options) {
+  if (options.isUndefined()) {
+    return getUIWorkletRuntime()->executeSync(rt, worklet);
+  }
+  auto optionsObject = options.asObject(rt);
+  auto timeout = optionsObject.getProperty(rt, "timeout");
+  if (timeout.isUndefined()) {
+    return getUIWorkletRuntime()->executeSync(rt, worklet);
+  }
+  // NaN and infinity can't be converted to a duration
+  if (!timeout.isNumber() || !std::isfinite(timeout.asNumber()) ||
+      timeout.asNumber() < 0) {
+    throw std::runtime_error(
+        "[Reanimated] `timeout` must be a finite, non-negative number of milliseconds.");
+  }
+  auto onTimeout = parseExecuteSyncTimeoutBehavior(
+      rt, optionsObject.getProperty(rt, "onTimeout"));
+  auto timeoutMs = timeout.asNumber();
+  auto result = getUIWorkletRuntime()->tryExecuteSync(
+      rt, worklet, std::chrono::duration<double, std::milli>(timeoutMs));
+  if (result.has_value()) {
+    return std::move(*result);
+  }
+  switch (onTimeout) {
+    case ExecuteSyncTimeoutBehavior::Throw:
+      throw std::runtime_error(
+          "[Reanimated] `executeOnUIRuntimeSync` timed out waiting for the UI runtime.");
+    case ExecuteSyncTimeoutBehavior::Async:
+      // the worklet still runs, but its result is lost
+      scheduleOnUI(rt, worklet, jsi::Value::undefined());
+      break;
+    case ExecuteSyncTimeoutBehavior::Skip:
+      break;
+  }
+  return jsi::Value::undefined();
+}
+
+jsi::Value NativeReanimatedModule::getUIRuntimeLockStats(jsi::Runtime &rt) {
+  return getUIWorkletRuntime()->getLockStats(rt);
+}
+
+jsi::Value NativeReanimatedModule::getFrameBudgetStats(jsi::Runtime &rt) {
+  auto stats = frameBudget_.getStats();
+  jsi::Object result(rt);
+  result.setProperty(rt, "frames", static_cast<double>(stats.frames));
+  result.setProperty(
+      rt, "overBudgetFrames", static_cast<double>(stats.overBudgetFrames));
+  result.setProperty(
+      rt, "deferredCallbacks", static_cast<double>(stats.deferredCallbacks));
+  result.setProperty(rt, "budgetMs", stats.budgetMs);
+  result.setProperty(rt, "frameIntervalMs", stats.frameIntervalMs);
+  result.setProperty(rt, "longestFrameMs", stats.longestFrameMs);
+  return result;
+}
+
+static AsyncQueueConfig parseAsyncQueueConfig(
+    jsi::Runtime &rt,
+    const jsi::Value &config) {
+  AsyncQueueConfig queueConfig;
+  if (config.isUndefined()) {
+    return queueConfig;
+  }
+  auto configObject = config.asObject(rt);
+  auto capacity = configObject.getProperty(rt, "queueCapacity");
+  if (!capacity.isUndefined()) {
+    if (!capacity.isNumber() || capacity.asNumber() < 0) {
+      throw std::runtime_error(
+          "[Reanimated] Queue capacity must be a non-negative number.");
+    }
+    queueConfig.capacity = static_cast<size_t>(capacity.asNumber());
+  }
+  auto overflowPolicy = configObject.getProperty(rt, "queueOverflowPolicy");
+  if (!overflowPolicy.isUndefined()) {
+    auto policy = overflowPolicy.isString()
+        ? overflowPolicy.asString(rt).utf8(rt)
+        : std::string();
+    if (policy == "block") {
+      queueConfig.overflowPolicy = AsyncQueueOverflowPolicy::Block;
+    } else if (policy == "dropOldest") {
+      queueConfig.overflowPolicy = AsyncQueueOverflowPolicy::DropOldest;
+    } else if (policy == "dropNewest") {
+      queueConfig.overflowPolicy = AsyncQueueOverflowPolicy::DropNewest;
+    } else if (policy == "merge") {
+      queueConfig.overflowPolicy = AsyncQueueOverflowPolicy::Merge;
+    } else {
+      throw std::runtime_error(
+          "[Reanimated] Queue overflow policy must be one of 'block', 'dropOldest', 'dropNewest' or 'merge'.");
+    }
+  }
+  return queueConfig;
+}
+
+static uint64_t parseHeapSize(
+    jsi::Runtime &rt,
+    const jsi::Object &configObject,
+    const char *name) {
+  auto heapSize = configObject.getProperty(rt, name);
+  if (heapSize.isUndefined()) {
+    return 0;
+  }
+  // Hermes takes heap sizes as 32-bit numbers of bytes.
+  constexpr double maxHeapSize = std::numeric_limits<uint32_t>::max();
+  if (!heapSize.isNumber() || heapSize.asNumber() < 0 ||
+      heapSize.asNumber() > maxHeapSize) {
+    throw std::runtime_error(
+        std::string("[Reanimated] `") + name +
+        "` must be a non-negative number of bytes less than 4 GiB.");
+  }
+  return static_cast<uint64_t>(heapSize.asNumber());
+}
+
+static RuntimeConfig parseRuntimeConfig(
+    jsi::Runtime &rt,
+    const jsi::Value &config) {
+  RuntimeConfig runtimeConfig;
+  if (config.isUndefined()) {
+    return runtimeConfig;
+  }
+  auto configObject = config.asObject(rt);
+  runtimeConfig.initialHeapSize =
+      parseHeapSize(rt, configObject, "initialHeapSize");
+  runtimeConfig.maxHeapSize = parseHeapSize(rt, configObject, "maxHeapSize");
+  auto gcMode = configObject.getProperty(rt, "gcMode");
+  if (!gcMode.isUndefined()) {
+    auto mode =
+        gcMode.isString() ? gcMode.asString(rt).utf8(rt) : std::string();
+    if (mode == "default") {
+      runtimeConfig.gcMode = RuntimeGCMode::Default;
+    } else if (mode == "compact") {
+      runtimeConfig.gcMode = RuntimeGCMode::Compact;
+    } else if (mode == "lowLatency") {
+      runtimeConfig.gcMode = RuntimeGCMode::LowLatency;
+    } else {
+      throw std::runtime_error(
+          "[Reanimated] GC mode must be one of 'default', 'compact' or 'lowLatency'.");
+    }
+  }
+  auto enableMicrotasks = configObject.getProperty(rt, "enableMicrotasks");
+  if (!enableMicrotasks.isUndefined()) {
+#if REACT_NATIVE_MINOR_VERSION >= 71
+    runtimeConfig.enableMicrotasks = enableMicrotasks.getBool();
+#else
+    if (enableMicrotasks.getBool()) {
+      throw std::runtime_error(
+          "[Reanimated] `enableMicrotasks` requires React Native 0.71 or newer.");
+    }
+#endif // REACT_NATIVE_MINOR_VERSION
+  }
+  auto enableDebugger = configObject.getProperty(rt, "enableDebugger");
+  if (!enableDebugger.isUndefined()) {
+    runtimeConfig.enableDebugger = enableDebugger.getBool();
+  }
+  auto usePrecompiledWorklets =
+      configObject.getProperty(rt, "usePrecompiledWorklets");
+  if (!usePrecompiledWorklets.isUndefined()) {
+    runtimeConfig.usePrecompiledWorklets = usePrecompiledWorklets.getBool();
+  }
+  return runtimeConfig;
 }
 
 jsi::Value NativeReanimatedModule::createWorkletRuntime(
     jsi::Runtime &rt,
     const jsi::Value &name,
-    const jsi::Value &initializer) {
+    const jsi::Value &initializer,
+    const jsi::Value &config) {
   auto workletRuntime = std::make_shared<WorkletRuntime>(
       rt,
       jsQueue_,
       jsScheduler_,
       name.asString(rt).utf8(rt),
       false /* supportsLocking */,
-      valueUnpackerCode_);
+      valueUnpackerCode_,
+      parseAsyncQueueConfig(rt, config),
+      parseRuntimeConfig(rt, config));
   auto initializerShareable = extractShareableOrThrow<ShareableWorklet>(
       rt, initializer, "[Reanimated] Initializer must be a worklet.");
   workletRuntime->runGuarded(initializerShareable);
   return jsi::Object::createFromHostObject(rt, workletRuntime);
 }
 
+jsi::Value NativeReanimatedModule::createWorkletRuntimePool(
+    jsi::Runtime &rt,
+    const jsi::Value &name,
+    const jsi::Value &size,
+    const jsi::Value &initializer) {
+  size_t poolSize;
+  if (size.isUndefined()) {
+    // leave some cores for the JS and UI threads
+    auto cores = static_cast<size_t>(std::thread::hardware_concurrency());
+    poolSize = cores > 3 ? cores - 2 : 1;
+  } else if (size.isNumber() && size.asNumber() >= 1) {
+    poolSize = static_cast<size_t>(size.asNumber());
+  } else {
+    throw std::runtime_error(
+        "[Reanimated] Worklet runtime pool size must be a positive number.");
+  }
+  auto initializerShareable = extractShareableOrThrow<ShareableWorklet>(
+      rt, initializer, "[Reanimated] Initializer must be a worklet.");
+  auto pool = std::make_shared<WorkletRuntimePool>(
+      rt,
+      jsQueue_,
+      jsScheduler_,
+      name.asString(rt).utf8(rt),
+      poolSize,
+      valueUnpackerCode_,
+      initializerShareable);
+  return jsi::Object::createFromHostObject(rt, pool);
+}
+
 jsi::Value NativeReanimatedModule::scheduleOnRuntime(
     jsi::Runtime &rt,
     const jsi::Value &workletRuntimeValue,
-    const jsi::Value &shareableWorkletValue) {
-  reanimated::scheduleOnRuntime(rt, workletRuntimeValue, shareableWorkletValue);
+    const jsi::Value &shareableWorkletValue,
+    const jsi::Value &mergeKeyValue) {
+  reanimated::scheduleOnRuntime(
+      rt, workletRuntimeValue, shareableWorkletValue, mergeKeyValue);
   return jsi::Value::undefined();
 }
 
+// Settles a promise created on the RN runtime from any thread, always on the
+// JS thread. If the job that owns the settler is destroyed without settling
+// it, e.g. because the queue of a worklet runtime dropped it, the promise is
+// rejected so that it doesn't stay pending forever.
+class PromiseSettler {
+ public:
+  PromiseSettler(
+      const std::shared_ptr<JSScheduler> &jsScheduler,
+      jsi::Function &&resolve,
+      jsi::Function &&reject)
+      : jsScheduler_(jsScheduler),
+        callbacks_(std::make_shared<Callbacks>(
+            Callbacks{std::move(resolve), std::move(reject)})) {}
+
+  ~PromiseSettler() {
+    reject("[Reanimated] The worklet was dropped before it could run.");
+  }
+
+  void resolve(const std::shared_ptr<Shareable> &result) {
+    if (callbacks_ == nullptr) {
+      return;
+    }
+    jsScheduler_->scheduleOnJS(
+        [callbacks = std::move(callbacks_), result](jsi::Runtime &rt) {
+          callbacks->resolve.call(rt, result->getJSValue(rt));
+        });
+  }
+
+  void reject(const std::string &message) {
+    if (callbacks_ == nullptr) {
+      return;
+    }
+    jsScheduler_->scheduleOnJS(
+        [callbacks = std::move(callbacks_), message](jsi::Runtime &rt) {
+          auto error = rt.global()
+                           .getPropertyAsFunction(rt, "Error")
+                           .callAsConstructor(
+                               rt, jsi::String::createFromUtf8(rt, message));
+          callbacks->reject.call(rt, error);
+        });
+  }
+
+ private:
+  struct Callbacks {
+    jsi::Function resolve;
+    jsi::Function reject;
+  };
+
+  const std::shared_ptr<JSScheduler> jsScheduler_;
+  std::shared_ptr<Callbacks> callbacks_;
+};
+
+// Runs the worklet without the call guard so that errors it throws reject the
+// promise instead of being reported to LogBox.
+static void runAndSettle(
+    WorkletRuntime &workletRuntime,
+    const std::shared_ptr<ShareableWorklet> &shareableWorklet,
+    PromiseSettler &settler) {
+  jsi::Runtime &rt = workletRuntime.getJSIRuntime();
+  // the result is converted to a shareable under the same lock
+  auto runtimeLock = workletRuntime.lock();
+#if JS_RUNTIME_HERMES
+  const auto scope = jsi::Scope(rt);
+#endif
+  try {
+    auto result = workletRuntime.runUnguarded(shareableWorklet);
+    settler.resolve(extractShareableOrThrow(
+        rt,
+        result,
+        "[Reanimated] The result of a worklet passed to `runOnRuntimeAsync` must be shareable."));
+  } catch (const jsi::JSError &error) {
+    settler.reject(error.getMessage());
+  } catch (const std::exception &error) {
+    settler.reject(error.what());
+  }
+}
+
+jsi::Value NativeReanimatedModule::runOnRuntimeAsync(
+    jsi::Runtime &rt,
+    const jsi::Value &workletRuntimeValue,
+    const jsi::Value &shareableWorkletValue) {
+  auto shareableWorklet = extractShareableOrThrow<ShareableWorklet>(
+      rt,
+      shareableWorkletValue,
+      "[Reanimated] Function passed to `runOnRuntimeAsync` is not a shareable worklet.");
+  // the UI runtime is used when no worklet runtime is given
+  auto workletRuntime = workletRuntimeValue.isUndefined()
+      ? nullptr
+      : extractWorkletRuntime(rt, workletRuntimeValue);
+
+  std::shared_ptr<PromiseSettler> settler;
+  auto executor = jsi::Function::createFromHostFunction(
+      rt,
+      jsi::PropNameID::forAscii(rt, "executor"),
+      2,
+      [&](jsi::Runtime &rt,
+          const jsi::Value &,
+          const jsi::Value *args,
+          size_t) -> jsi::Value {
+        settler = std::make_shared<PromiseSettler>(
+            jsScheduler_,
+            args[0].asObject(rt).asFunction(rt),
+            args[1].asObject(rt).asFunction(rt));
+        return jsi::Value::undefined();
+      });
+  auto promise = rt.global()
+                     .getPropertyAsFunction(rt, "Promise")
+                     .callAsConstructor(rt, executor);
+
+  if (workletRuntime == nullptr) {
+    scheduleOnUIRuntime([=] {
+      runAndSettle(*getUIWorkletRuntime(), shareableWorklet, *settler);
+    });
+  } else {
+    // merging would drop calls whose promises are still awaited, hence no
+    // merge key here
+    workletRuntime->runAsync([=] {
+      runAndSettle(*workletRuntime, shareableWorklet, *settler);
+    });
+  }
+  return promise;
+}
+
 jsi::Value NativeReanimatedModule::makeShareableClone(
     jsi::Runtime &rt,
     const jsi::Value &value,
-    const jsi::Value &shouldRetainRemote) {
-  return reanimated::makeShareableClone(rt, value, shouldRetainRemote);
+    const jsi::Value &shouldRetainRemote,
+    const jsi::Value &arrayBufferTransferMode,
+    const jsi::Value &isTypedArray,
+    const jsi::Value &isPlainData) {
+  return reanimated::makeShareableClone(
+      rt,
+      value,
+      shouldRetainRemote,
+      arrayBufferTransferMode,
+      isTypedArray,
+      isPlainData);
+}
+
+void NativeReanimatedModule::enableShareableDeduplication(
+    jsi::Runtime &,
+    const jsi::Value &flag) {
+  FeaturesConfig::setShareableDeduplicationEnabled(flag.getBool());
 }
 
 jsi::Value NativeReanimatedModule::registerEventHandler(
@@ -213,11 +695,15 @@ jsi::Value NativeReanimatedModule::registerEventHandler(
       rt, worklet, "[Reanimated] Event handler must be a worklet.");
   int emitterReactTagInt = emitterReactTag.asNumber();
 
-  uiScheduler_->scheduleOnUI([=] {
-    auto handler = std::make_shared<WorkletEventHandler>(
-        newRegistrationId, eventNameStr, emitterReactTagInt, handlerShareable);
-    eventHandlerRegistry_->registerEventHandler(std::move(handler));
-  });
+  scheduleOnUIRuntime(
+      [=] {
+        auto handler = std::make_shared<WorkletEventHandler>(
+            newRegistrationId,
+            eventNameStr,
+            emitterReactTagInt,
+            handlerShareable);
+        eventHandlerRegistry_->registerEventHandler(std::move(handler));
+      });
 
   return jsi::Value(static_cast<double>(newRegistrationId));
 }
@@ -226,7 +712,7 @@ void NativeReanimatedModule::unregisterEventHandler(
     jsi::Runtime &,
     const jsi::Value &registrationId) {
   uint64_t id = registrationId.asNumber();
-  uiScheduler_->scheduleOnUI(
+  scheduleOnUIRuntime(
       [=] { eventHandlerRegistry_->unregisterEventHandler(id); });
 }
 
@@ -244,20 +730,22 @@ jsi::Value NativeReanimatedModule::getViewProp(
   const auto funPtr = std::make_shared<jsi::Function>(
       callback.getObject(rnRuntime).asFunction(rnRuntime));
 
-  uiScheduler_->scheduleOnUI([=]() {
-    jsi::Runtime &uiRuntime = uiWorkletRuntime_->getJSIRuntime();
-    const auto propNameValue =
-        jsi::String::createFromUtf8(uiRuntime, propNameStr);
-    const auto resultValue =
-        obtainPropFunction_(uiRuntime, viewTagInt, propNameValue);
-    const auto resultStr = resultValue.asString(uiRuntime).utf8(uiRuntime);
-
-    jsScheduler_->scheduleOnJS([=](jsi::Runtime &rnRuntime) {
-      const auto resultValue =
-          jsi::String::createFromUtf8(rnRuntime, resultStr);
-      funPtr->call(rnRuntime, resultValue);
-    });
-  });
+  scheduleOnUIRuntime(
+      [=]() {
+        jsi::Runtime &uiRuntime = getUIRuntime();
+        const auto propNameValue =
+            jsi::String::createFromUtf8(uiRuntime, propNameStr);
+        const auto resultValue =
+            obtainPropFunction_(uiRuntime, viewTagInt, propNameValue);
+        const auto resultStr = resultValue.asString(uiRuntime).utf8(uiRuntime);
+
+        jsScheduler_->scheduleOnJS([=](jsi::Runtime &rnRuntime) {
+          const auto resultValue =
+              jsi::String::createFromUtf8(rnRuntime, resultStr);
+          funPtr->call(rnRuntime, resultValue);
+        });
+      },
+      UILane::Deferrable);
 
   return jsi::Value::undefined();
 #endif
@@ -358,22 +846,62 @@ void NativeReanimatedModule::requestAnimationFrame(
   maybeRequestRender();
 }
 
+void NativeReanimatedModule::requestDeferrableAnimationFrame(
+    jsi::Runtime &rt,
+    const jsi::Value &callback) {
+  deferrableFrameCallbacks_.push_back(
+      std::make_shared<jsi::Value>(rt, callback));
+  maybeRequestRender();
+}
+
 void NativeReanimatedModule::maybeRequestRender() {
   if (!renderRequested_) {
     renderRequested_ = true;
-    jsi::Runtime &uiRuntime = uiWorkletRuntime_->getJSIRuntime();
+    jsi::Runtime &uiRuntime = getUIRuntime();
     requestRender_(onRenderCallback_, uiRuntime);
   }
 }
 
 void NativeReanimatedModule::onRender(double timestampMs) {
+  if (!isUIRuntimeReady()) {
+    // frame callbacks are requested from the UI runtime, so there are none
+    return;
+  }
+  // calls to JS made by all the frame callbacks are delivered together
+  JSScheduler::Batch jsBatch(jsScheduler_);
+  auto uiRuntimeLock = lockUIRuntime();
+  frameBudget_.beginFrame(timestampMs);
   auto callbacks = std::move(frameCallbacks_);
   frameCallbacks_.clear();
-  jsi::Runtime &uiRuntime = uiWorkletRuntime_->getJSIRuntime();
+  auto deferrableCallbacks = std::move(deferrableFrameCallbacks_);
+  deferrableFrameCallbacks_.clear();
+  jsi::Runtime &uiRuntime = getUIRuntime();
   jsi::Value timestamp{timestampMs};
   for (const auto &callback : callbacks) {
     runOnRuntimeGuarded(uiRuntime, *callback, timestamp);
   }
+
+  // At least one deferrable callback runs in every frame, so that they make
+  // progress even when the frame is already over budget.
+  size_t i = 0;
+  for (; i < deferrableCallbacks.size(); i++) {
+    if (i > 0 && !frameBudget_.hasTimeForCallback()) {
+      break;
+    }
+    auto startTime = std::chrono::steady_clock::now();
+    runOnRuntimeGuarded(uiRuntime, *deferrableCallbacks[i], timestamp);
+    frameBudget_.endCallback(startTime);
+  }
+  auto deferredCount = deferrableCallbacks.size() - i;
+  if (deferredCount > 0) {
+    // postponed callbacks run before the ones requested during this frame
+    deferrableFrameCallbacks_.insert(
+        deferrableFrameCallbacks_.begin(),
+        std::make_move_iterator(deferrableCallbacks.begin() + i),
+        std::make_move_iterator(deferrableCallbacks.end()));
+    maybeRequestRender();
+  }
+  frameBudget_.endFrame(deferredCount);
 }
 
 jsi::Value NativeReanimatedModule::registerSensor(
@@ -384,7 +912,7 @@ jsi::Value NativeReanimatedModule::registerSensor(
     const jsi::Value &sensorDataHandler) {
   return animatedSensorModule_.registerSensor(
       rt,
-      uiWorkletRuntime_,
+      getUIWorkletRuntime(),
       sensorType,
       interval,
       iosReferenceFrame,
@@ -447,8 +975,14 @@ bool NativeReanimatedModule::handleEvent(
     const int emitterReactTag,
     const jsi::Value &payload,
     double currentTime) {
+  if (!isUIRuntimeReady()) {
+    // Event handlers are registered on the UI runtime, so there are none yet.
+    return false;
+  }
+  JSScheduler::Batch jsBatch(jsScheduler_);
+  auto uiRuntimeLock = lockUIRuntime();
   eventHandlerRegistry_->processEvent(
-      uiWorkletRuntime_, currentTime, eventName, emitterReactTag, payload);
+      getUIWorkletRuntime(), currentTime, eventName, emitterReactTag, payload);
 
   // TODO: return true if Reanimated successfully handled the event
   // to avoid sending it to JavaScript
@@ -459,6 +993,10 @@ bool NativeReanimatedModule::handleEvent(
 bool NativeReanimatedModule::handleRawEvent(
     const RawEvent &rawEvent,
     double currentTime) {
+  if (!isUIRuntimeReady()) {
+    // see `handleEvent`
+    return false;
+  }
   const EventTarget *eventTarget = rawEvent.eventTarget.get();
   if (eventTarget == nullptr) {
     // after app reload scrollview is unmounted and its content offset is set to
@@ -473,7 +1011,9 @@ bool NativeReanimatedModule::handleRawEvent(
   if (eventType.rfind("top", 0) == 0) {
     eventType = "on" + eventType.substr(3);
   }
-  jsi::Runtime &rt = uiWorkletRuntime_->getJSIRuntime();
+  // held across `handleEvent` and `performOperations` as well
+  auto uiRuntimeLock = lockUIRuntime();
+  jsi::Runtime &rt = getUIRuntime();
 #if REACT_NATIVE_MINOR_VERSION >= 73
   const auto &eventPayload = rawEvent.eventPayload;
   jsi::Value payload = eventPayload->asJSIValue(rt);
@@ -514,11 +1054,17 @@ void NativeReanimatedModule::performOperations() {
     // nothing to do
     return;
   }
+  if (!isUIRuntimeReady()) {
+    // Operations are only added by the UI runtime, the tags to remove wait for
+    // the next call.
+    return;
+  }
 
+  auto uiRuntimeLock = lockUIRuntime();
   auto copiedOperationsQueue = std::move(operationsInBatch_);
   operationsInBatch_.clear();
 
-  jsi::Runtime &rt = uiWorkletRuntime_->getJSIRuntime();
+  jsi::Runtime &rt = getUIRuntime();
 
   {
     auto lock = propsRegistry_->createLock();
@@ -547,14 +1093,11 @@ void NativeReanimatedModule::performOperations() {
       continue;
     }
     Tag viewTag = shadowNode->getTag();
-    jsi::Value maybeJSPropsUpdater =
-        rt.global().getProperty(rt, "updateJSProps");
+    auto jsPropsUpdater =
+        GlobalFunctionHandles::get(rt, GlobalFunction::UpdateJSProps);
     assert(
-        maybeJSPropsUpdater.isObject() &&
-        "[Reanimated] `updateJSProps` not found");
-    jsi::Function jsPropsUpdater =
-        maybeJSPropsUpdater.asObject(rt).asFunction(rt);
-    jsPropsUpdater.call(rt, viewTag, nonAnimatableProps);
+        jsPropsUpdater != nullptr && "[Reanimated] `updateJSProps` not found");
+    jsPropsUpdater->call(rt, viewTag, nonAnimatableProps);
   }
 
   bool hasLayoutUpdates = false;
@@ -725,8 +1268,16 @@ jsi::Value NativeReanimatedModule::subscribeForKeyboardEvents(
       "[Reanimated] Keyboard event handler must be a worklet.");
   return subscribeForKeyboardEventsFunction_(
       [=](int keyboardState, int height) {
-        uiWorkletRuntime_->runGuarded(
-            shareableHandler, jsi::Value(keyboardState), jsi::Value(height));
+        auto runHandler = [=] {
+          getUIWorkletRuntime()->runGuarded(
+              shareableHandler, jsi::Value(keyboardState), jsi::Value(height));
+        };
+        if (isUIRuntimeReady()) {
+          runHandler();
+        } else {
+          // the handler needs to know the latest keyboard state
+          scheduleOnUIRuntime(std::move(runHandler));
+        }
       },
       isStatusBarTranslucent.getBool());
 }
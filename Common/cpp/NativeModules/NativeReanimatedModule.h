@@ -4,18 +4,26 @@
 #include <react/renderer/uimanager/UIManager.h>
 #endif
 
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include "AnimatedSensorModule.h"
 #include "EventHandlerRegistry.h"
+#include "FrameBudget.h"
 #include "JSScheduler.h"
 #include "LayoutAnimationsManager.h"
 #include "NativeReanimatedModuleSpec.h"
 #include "PlatformDepMethodsHolder.h"
+#include "RuntimeLock.h"
 #include "SingleInstanceChecker.h"
 #include "UIScheduler.h"
 
@@ -44,17 +52,40 @@ class NativeReanimatedModule : public NativeReanimatedModuleSpec {
   jsi::Value makeShareableClone(
       jsi::Runtime &rt,
       const jsi::Value &value,
-      const jsi::Value &shouldRetainRemote) override;
-
-  void scheduleOnUI(jsi::Runtime &rt, const jsi::Value &worklet) override;
-  jsi::Value executeOnUIRuntimeSync(jsi::Runtime &rt, const jsi::Value &worklet)
+      const jsi::Value &shouldRetainRemote,
+      const jsi::Value &arrayBufferTransferMode,
+      const jsi::Value &isTypedArray,
+      const jsi::Value &isPlainData) override;
+  void enableShareableDeduplication(jsi::Runtime &rt, const jsi::Value &flag)
       override;
 
+  void scheduleOnUI(
+      jsi::Runtime &rt,
+      const jsi::Value &worklet,
+      const jsi::Value &lane) override;
+  jsi::Value executeOnUIRuntimeSync(
+      jsi::Runtime &rt,
+      const jsi::Value &worklet,
+      const jsi::Value &options) override;
+  jsi::Value getUIRuntimeLockStats(jsi::Runtime &rt) override;
+  jsi::Value getFrameBudgetStats(jsi::Runtime &rt) override;
+
   jsi::Value createWorkletRuntime(
       jsi::Runtime &rt,
       const jsi::Value &name,
+      const jsi::Value &initializer,
+      const jsi::Value &config) override;
+  jsi::Value createWorkletRuntimePool(
+      jsi::Runtime &rt,
+      const jsi::Value &name,
+      const jsi::Value &size,
       const jsi::Value &initializer) override;
   jsi::Value scheduleOnRuntime(
+      jsi::Runtime &rt,
+      const jsi::Value &workletRuntimeValue,
+      const jsi::Value &shareableWorkletValue,
+      const jsi::Value &mergeKeyValue) override;
+  jsi::Value runOnRuntimeAsync(
       jsi::Runtime &rt,
       const jsi::Value &workletRuntimeValue,
       const jsi::Value &shareableWorkletValue) override;
@@ -154,12 +185,46 @@ class NativeReanimatedModule : public NativeReanimatedModuleSpec {
     return layoutAnimationsManager_;
   }
 
+  // The UI runtime is created in the background. Until it's ready, code on the
+  // UI thread should skip or postpone the work that needs it rather than block
+  // the thread.
+  inline bool isUIRuntimeReady() const {
+    return isUIRuntimeReady_.load(std::memory_order_acquire);
+  }
+
+  // Blocks until the UI runtime is ready, see `isUIRuntimeReady`.
+  inline const std::shared_ptr<WorkletRuntime> &getUIWorkletRuntime() {
+    if (!isUIRuntimeReady_.load(std::memory_order_acquire)) {
+      waitForUIRuntime();
+    }
+    return uiWorkletRuntime_;
+  }
+
   inline jsi::Runtime &getUIRuntime() {
-    return uiWorkletRuntime_->getJSIRuntime();
+    return getUIWorkletRuntime()->getJSIRuntime();
+  }
+
+  // Should be held around code that makes many calls to the UI runtime outside
+  // of a worklet, see `WorkletRuntime::lock`.
+  inline std::unique_lock<RuntimeLock> lockUIRuntime() {
+    return getUIWorkletRuntime()->lock();
   }
 
+  // Schedules a job that uses the UI runtime on the UI thread, holding it
+  // back until the runtime is ready.
+  void scheduleOnUIRuntime(UIJob &&job, UILane lane = UILane::Urgent);
+
  private:
+  void initializeUIRuntime(
+      jsi::Runtime &rnRuntime,
+      const std::shared_ptr<MessageQueueThread> &jsQueue,
+      const std::function<void(jsi::Runtime &)> &decorateUIRuntime);
+  void waitForUIRuntime();
+
   void requestAnimationFrame(jsi::Runtime &rt, const jsi::Value &callback);
+  void requestDeferrableAnimationFrame(
+      jsi::Runtime &rt,
+      const jsi::Value &callback);
 
 #ifdef RCT_NEW_ARCH_ENABLED
   bool isThereAnyLayoutProp(jsi::Runtime &rt, const jsi::Object &props);
@@ -171,12 +236,24 @@ class NativeReanimatedModule : public NativeReanimatedModuleSpec {
   const std::shared_ptr<MessageQueueThread> jsQueue_;
   const std::shared_ptr<JSScheduler> jsScheduler_;
   const std::shared_ptr<UIScheduler> uiScheduler_;
-  std::shared_ptr<WorkletRuntime> uiWorkletRuntime_;
   std::string valueUnpackerCode_;
 
+  // Set once, before `isUIRuntimeReady_`.
+  std::shared_ptr<WorkletRuntime> uiWorkletRuntime_;
+  std::atomic_bool isUIRuntimeReady_{false};
+  // Protects `uiRuntimeError_` and `pendingUIJobs_`.
+  std::mutex uiRuntimeMutex_;
+  std::condition_variable uiRuntimeCv_;
+  std::exception_ptr uiRuntimeError_;
+  std::vector<std::pair<UIJob, UILane>> pendingUIJobs_;
+  std::thread uiRuntimeInitThread_;
+
   std::unique_ptr<EventHandlerRegistry> eventHandlerRegistry_;
   const RequestRenderFunction requestRender_;
   std::vector<std::shared_ptr<jsi::Value>> frameCallbacks_;
+  // Run after `frameCallbacks_`, only as long as the frame budget allows.
+  std::vector<std::shared_ptr<jsi::Value>> deferrableFrameCallbacks_;
+  FrameBudget frameBudget_;
   volatile bool renderRequested_{false};
   const std::function<void(const double)> onRenderCallback_;
   AnimatedSensorModule animatedSensorModule_;
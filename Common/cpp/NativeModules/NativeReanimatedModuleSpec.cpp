@@ -12,9 +12,33 @@ static jsi::Value SPEC_PREFIX(makeShareableClone)(
     jsi::Runtime &rt,
     TurboModule &turboModule,
     const jsi::Value *args,
-    size_t) {
+    size_t count) {
+  // the transfer mode is optional and only used for array buffers and typed
+  // arrays
+  auto arrayBufferTransferMode =
+      count > 2 ? jsi::Value(rt, args[2]) : jsi::Value::undefined();
+  auto isTypedArray =
+      count > 3 ? jsi::Value(rt, args[3]) : jsi::Value::undefined();
+  auto isPlainData =
+      count > 4 ? jsi::Value(rt, args[4]) : jsi::Value::undefined();
   return static_cast<NativeReanimatedModuleSpec *>(&turboModule)
-      ->makeShareableClone(rt, std::move(args[0]), std::move(args[1]));
+      ->makeShareableClone(
+          rt,
+          std::move(args[0]),
+          std::move(args[1]),
+          std::move(arrayBufferTransferMode),
+          std::move(isTypedArray),
+          std::move(isPlainData));
+}
+
+static jsi::Value SPEC_PREFIX(enableShareableDeduplication)(
+    jsi::Runtime &rt,
+    TurboModule &turboModule,
+    const jsi::Value *args,
+    size_t) {
+  static_cast<NativeReanimatedModuleSpec *>(&turboModule)
+      ->enableShareableDeduplication(rt, std::move(args[0]));
+  return jsi::Value::undefined();
 }
 
 // scheduler
@@ -23,9 +47,11 @@ static jsi::Value SPEC_PREFIX(scheduleOnUI)(
     jsi::Runtime &rt,
     TurboModule &turboModule,
     const jsi::Value *args,
-    size_t) {
+    size_t count) {
+  // the lane is optional, jobs are urgent by default
+  auto lane = count > 1 ? jsi::Value(rt, args[1]) : jsi::Value::undefined();
   static_cast<NativeReanimatedModuleSpec *>(&turboModule)
-      ->scheduleOnUI(rt, std::move(args[0]));
+      ->scheduleOnUI(rt, std::move(args[0]), std::move(lane));
   return jsi::Value::undefined();
 }
 
@@ -33,27 +59,72 @@ static jsi::Value SPEC_PREFIX(executeOnUIRuntimeSync)(
     jsi::Runtime &rt,
     TurboModule &turboModule,
     const jsi::Value *args,
+    size_t count) {
+  // the options are optional, the call waits for the UI runtime by default
+  auto options = count > 1 ? jsi::Value(rt, args[1]) : jsi::Value::undefined();
+  return static_cast<NativeReanimatedModuleSpec *>(&turboModule)
+      ->executeOnUIRuntimeSync(rt, std::move(args[0]), std::move(options));
+}
+
+static jsi::Value SPEC_PREFIX(getUIRuntimeLockStats)(
+    jsi::Runtime &rt,
+    TurboModule &turboModule,
+    const jsi::Value *,
     size_t) {
   return static_cast<NativeReanimatedModuleSpec *>(&turboModule)
-      ->executeOnUIRuntimeSync(rt, std::move(args[0]));
+      ->getUIRuntimeLockStats(rt);
+}
+
+static jsi::Value SPEC_PREFIX(getFrameBudgetStats)(
+    jsi::Runtime &rt,
+    TurboModule &turboModule,
+    const jsi::Value *,
+    size_t) {
+  return static_cast<NativeReanimatedModuleSpec *>(&turboModule)
+      ->getFrameBudgetStats(rt);
 }
 
 static jsi::Value SPEC_PREFIX(createWorkletRuntime)(
+    jsi::Runtime &rt,
+    TurboModule &turboModule,
+    const jsi::Value *args,
+    size_t count) {
+  // the config is optional
+  auto config = count > 2 ? jsi::Value(rt, args[2]) : jsi::Value::undefined();
+  return static_cast<NativeReanimatedModuleSpec *>(&turboModule)
+      ->createWorkletRuntime(
+          rt, std::move(args[0]), std::move(args[1]), std::move(config));
+}
+
+static jsi::Value SPEC_PREFIX(createWorkletRuntimePool)(
     jsi::Runtime &rt,
     TurboModule &turboModule,
     const jsi::Value *args,
     size_t) {
   return static_cast<NativeReanimatedModuleSpec *>(&turboModule)
-      ->createWorkletRuntime(rt, std::move(args[0]), std::move(args[1]));
+      ->createWorkletRuntimePool(
+          rt, std::move(args[0]), std::move(args[1]), std::move(args[2]));
 }
 
 static jsi::Value SPEC_PREFIX(scheduleOnRuntime)(
+    jsi::Runtime &rt,
+    TurboModule &turboModule,
+    const jsi::Value *args,
+    size_t count) {
+  // the merge key is optional
+  auto mergeKey = count > 2 ? jsi::Value(rt, args[2]) : jsi::Value::undefined();
+  return static_cast<NativeReanimatedModuleSpec *>(&turboModule)
+      ->scheduleOnRuntime(
+          rt, std::move(args[0]), std::move(args[1]), std::move(mergeKey));
+}
+
+static jsi::Value SPEC_PREFIX(runOnRuntimeAsync)(
     jsi::Runtime &rt,
     TurboModule &turboModule,
     const jsi::Value *args,
     size_t) {
   return static_cast<NativeReanimatedModuleSpec *>(&turboModule)
-      ->scheduleOnRuntime(rt, std::move(args[0]), std::move(args[1]));
+      ->runOnRuntimeAsync(rt, std::move(args[0]), std::move(args[1]));
 }
 
 static jsi::Value SPEC_PREFIX(registerEventHandler)(
@@ -187,15 +258,25 @@ NativeReanimatedModuleSpec::NativeReanimatedModuleSpec(
     const std::shared_ptr<CallInvoker> &jsInvoker)
     : TurboModule("NativeReanimated", jsInvoker) {
   methodMap_["makeShareableClone"] =
-      MethodMetadata{2, SPEC_PREFIX(makeShareableClone)};
+      MethodMetadata{5, SPEC_PREFIX(makeShareableClone)};
+  methodMap_["enableShareableDeduplication"] =
+      MethodMetadata{1, SPEC_PREFIX(enableShareableDeduplication)};
 
-  methodMap_["scheduleOnUI"] = MethodMetadata{1, SPEC_PREFIX(scheduleOnUI)};
+  methodMap_["scheduleOnUI"] = MethodMetadata{2, SPEC_PREFIX(scheduleOnUI)};
   methodMap_["executeOnUIRuntimeSync"] =
-      MethodMetadata{1, SPEC_PREFIX(executeOnUIRuntimeSync)};
+      MethodMetadata{2, SPEC_PREFIX(executeOnUIRuntimeSync)};
+  methodMap_["getUIRuntimeLockStats"] =
+      MethodMetadata{0, SPEC_PREFIX(getUIRuntimeLockStats)};
+  methodMap_["getFrameBudgetStats"] =
+      MethodMetadata{0, SPEC_PREFIX(getFrameBudgetStats)};
   methodMap_["createWorkletRuntime"] =
-      MethodMetadata{2, SPEC_PREFIX(createWorkletRuntime)};
+      MethodMetadata{3, SPEC_PREFIX(createWorkletRuntime)};
+  methodMap_["createWorkletRuntimePool"] =
+      MethodMetadata{3, SPEC_PREFIX(createWorkletRuntimePool)};
   methodMap_["scheduleOnRuntime"] =
-      MethodMetadata{2, SPEC_PREFIX(scheduleOnRuntime)};
+      MethodMetadata{3, SPEC_PREFIX(scheduleOnRuntime)};
+  methodMap_["runOnRuntimeAsync"] =
+      MethodMetadata{2, SPEC_PREFIX(runOnRuntimeAsync)};
 
   methodMap_["registerEventHandler"] =
       MethodMetadata{3, SPEC_PREFIX(registerEventHandler)};
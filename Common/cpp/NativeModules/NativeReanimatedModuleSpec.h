@@ -27,20 +27,43 @@ class JSI_EXPORT NativeReanimatedModuleSpec : public TurboModule {
   virtual jsi::Value makeShareableClone(
       jsi::Runtime &rt,
       const jsi::Value &value,
-      const jsi::Value &shouldRetainRemote) = 0;
+      const jsi::Value &shouldRetainRemote,
+      const jsi::Value &arrayBufferTransferMode,
+      const jsi::Value &isTypedArray,
+      const jsi::Value &isPlainData) = 0;
+  virtual void enableShareableDeduplication(
+      jsi::Runtime &rt,
+      const jsi::Value &flag) = 0;
 
   // Scheduling
-  virtual void scheduleOnUI(jsi::Runtime &rt, const jsi::Value &worklet) = 0;
+  virtual void scheduleOnUI(
+      jsi::Runtime &rt,
+      const jsi::Value &worklet,
+      const jsi::Value &lane) = 0;
   virtual jsi::Value executeOnUIRuntimeSync(
       jsi::Runtime &rt,
-      const jsi::Value &worklet) = 0;
+      const jsi::Value &worklet,
+      const jsi::Value &options) = 0;
+  virtual jsi::Value getUIRuntimeLockStats(jsi::Runtime &rt) = 0;
+  virtual jsi::Value getFrameBudgetStats(jsi::Runtime &rt) = 0;
 
   // Worklet runtime
   virtual jsi::Value createWorkletRuntime(
       jsi::Runtime &rt,
       const jsi::Value &name,
+      const jsi::Value &initializer,
+      const jsi::Value &config) = 0;
+  virtual jsi::Value createWorkletRuntimePool(
+      jsi::Runtime &rt,
+      const jsi::Value &name,
+      const jsi::Value &size,
       const jsi::Value &initializer) = 0;
   virtual jsi::Value scheduleOnRuntime(
+      jsi::Runtime &rt,
+      const jsi::Value &workletRuntimeValue,
+      const jsi::Value &shareableWorkletValue,
+      const jsi::Value &mergeKeyValue) = 0;
+  virtual jsi::Value runOnRuntimeAsync(
       jsi::Runtime &rt,
       const jsi::Value &workletRuntimeValue,
       const jsi::Value &shareableWorkletValue) = 0;
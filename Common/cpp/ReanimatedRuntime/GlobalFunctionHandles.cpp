@@ -0,0 +1,157 @@
+#include "GlobalFunctionHandles.h"
+#include "WorkletRuntimeRegistry.h"
+
+#include <cassert>
+#include <utility>
+
+namespace reanimated {
+
+std::unordered_map<
+    jsi::Runtime *,
+    std::shared_ptr<GlobalFunctionHandles::Handles>>
+    GlobalFunctionHandles::handles_{};
+std::mutex GlobalFunctionHandles::mutex_{};
+std::atomic<uint64_t> GlobalFunctionHandles::generation_{0};
+
+const jsi::Function *GlobalFunctionHandles::get(
+    jsi::Runtime &rt,
+    GlobalFunction function) {
+  auto handles = getHandles(rt);
+  if (handles == nullptr) {
+    return nullptr;
+  }
+  auto &slot = handles->functions[static_cast<size_t>(function)];
+  if (auto handle = slot.load(std::memory_order_acquire)) {
+    return handle;
+  }
+  // The UI runtime is used both from the UI and the JS thread, so another
+  // thread may resolve the same function in the meantime, in which case the
+  // handle it stored first is kept and `resolved` is destroyed.
+  auto resolved = resolve(rt, function);
+  if (resolved == nullptr) {
+    return nullptr;
+  }
+  jsi::Function *stored = nullptr;
+  if (!slot.compare_exchange_strong(
+          stored, resolved.get(), std::memory_order_acq_rel)) {
+    return stored;
+  }
+  // If `clear` was called in the meantime, the runtime is being torn down and
+  // the handle is leaked.
+  return resolved.release();
+}
+
+GlobalFunctionHandles::Handles *GlobalFunctionHandles::getHandles(
+    jsi::Runtime &rt) {
+  struct Entry {
+    const jsi::Runtime *runtime = nullptr;
+    uint64_t generation = 0;
+    std::shared_ptr<Handles> handles;
+  };
+  // A few entries, as e.g. the JS thread uses both the RN and the UI runtime.
+  static thread_local std::array<Entry, 4> entries;
+  static thread_local size_t nextEntry = 0;
+
+  auto generation = generation_.load(std::memory_order_acquire);
+  for (const auto &entry : entries) {
+    if (entry.runtime == &rt && entry.generation == generation) {
+      return entry.handles.get();
+    }
+  }
+  auto handles = lookupHandles(rt);
+  if (handles == nullptr) {
+    return nullptr;
+  }
+  auto &entry = entries[nextEntry];
+  nextEntry = (nextEntry + 1) % entries.size();
+  entry = Entry{&rt, generation, std::move(handles)};
+  return entry.handles.get();
+}
+
+std::shared_ptr<GlobalFunctionHandles::Handles>
+GlobalFunctionHandles::lookupHandles(jsi::Runtime &rt) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = handles_.find(&rt);
+  if (it != handles_.end()) {
+    return it->second;
+  }
+  if (!WorkletRuntimeRegistry::isRuntimeAlive(&rt)) {
+    // Without the registration we wouldn't know when to drop the handles.
+    assert(false && "[Reanimated] Runtime is not registered.");
+    return nullptr;
+  }
+  auto handles = std::make_shared<Handles>();
+  handles_.emplace(&rt, handles);
+  return handles;
+}
+
+void GlobalFunctionHandles::clear(jsi::Runtime &rt) {
+  std::shared_ptr<Handles> handles;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = handles_.find(&rt);
+    if (it == handles_.end()) {
+      return;
+    }
+    handles = std::move(it->second);
+    handles_.erase(it);
+    generation_.fetch_add(1, std::memory_order_release);
+  }
+  // The handles are released here, outside of the lock.
+  for (auto &slot : handles->functions) {
+    delete slot.exchange(nullptr, std::memory_order_acq_rel);
+  }
+}
+
+void GlobalFunctionHandles::forget(jsi::Runtime &rt) {
+  // See the comment in `cleanupIfRuntimeExists` for why we leak the handles
+  // of runtimes that are already gone, `Handles` doesn't release them.
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (handles_.erase(&rt) != 0) {
+    generation_.fetch_add(1, std::memory_order_release);
+  }
+}
+
+static jsi::Value getGlobalFunctionValue(
+    jsi::Runtime &rt,
+    GlobalFunction function) {
+  auto global = rt.global();
+  switch (function) {
+    case GlobalFunction::ValueUnpacker:
+      return global.getProperty(rt, "__valueUnpacker");
+    case GlobalFunction::CallGuard:
+      return global.getProperty(rt, "__callGuardDEV");
+    case GlobalFunction::LayoutAnimationsStart:
+    case GlobalFunction::LayoutAnimationsStop: {
+      auto layoutAnimationsManager =
+          global.getProperty(rt, "LayoutAnimationsManager");
+      if (!layoutAnimationsManager.isObject()) {
+        return jsi::Value::undefined();
+      }
+      return layoutAnimationsManager.asObject(rt).getProperty(
+          rt,
+          function == GlobalFunction::LayoutAnimationsStart ? "start" : "stop");
+    }
+    case GlobalFunction::UpdateJSProps:
+      return global.getProperty(rt, "updateJSProps");
+    case GlobalFunction::Count:
+      break;
+  }
+  return jsi::Value::undefined();
+}
+
+std::unique_ptr<jsi::Function> GlobalFunctionHandles::resolve(
+    jsi::Runtime &rt,
+    GlobalFunction function) {
+  auto value = getGlobalFunctionValue(rt, function);
+  if (!value.isObject()) {
+    return nullptr;
+  }
+  auto object = value.asObject(rt);
+  if (!object.isFunction(rt)) {
+    return nullptr;
+  }
+  return std::make_unique<jsi::Function>(object.asFunction(rt));
+}
+
+} // namespace reanimated
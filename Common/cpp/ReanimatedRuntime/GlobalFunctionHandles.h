@@ -0,0 +1,89 @@
+#pragma once
+
+#include <jsi/jsi.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+using namespace facebook;
+
+namespace reanimated {
+
+// Functions installed on the global object of a runtime that we call from C++
+// on hot paths.
+enum class GlobalFunction {
+  ValueUnpacker, // global.__valueUnpacker
+  CallGuard, // global.__callGuardDEV
+  LayoutAnimationsStart, // global.LayoutAnimationsManager.start
+  LayoutAnimationsStop, // global.LayoutAnimationsManager.stop
+  UpdateJSProps, // global.updateJSProps
+  Count,
+};
+
+// Resolves global functions once per runtime and keeps them as
+// `jsi::Function`s so that they don't have to be looked up by name on every
+// call. A function that is not defined (yet) is not cached and is looked up
+// again on the next call.
+//
+// Every runtime gets its own array of handles. Threads keep the arrays of the
+// runtimes they used recently, so `get` doesn't take any lock unless the
+// thread uses the runtime for the first time or a runtime was torn down in the
+// meantime. The process-wide map is only used to find the array on such a
+// miss and to release the handles on teardown.
+//
+// Handles are only kept for runtimes registered in WorkletRuntimeRegistry.
+// They are released by `clear` while the runtime is still alive, or leaked
+// when the runtime is already being torn down, see `cleanupIfRuntimeExists`.
+// Globals are assumed to be defined once and never reassigned.
+class GlobalFunctionHandles {
+ public:
+  // Returns the handle of `function` on `rt` or nullptr if it's not defined.
+  // Safe to call from any thread that may use `rt`, e.g. both the UI and the
+  // JS thread for the UI runtime. The handle stays valid until `rt` is
+  // destroyed.
+  static const jsi::Function *get(jsi::Runtime &rt, GlobalFunction function);
+
+  // Releases all handles of `rt`. Must be called before `rt` is destroyed.
+  static void clear(jsi::Runtime &rt);
+
+ private:
+  // The handles are owned manually rather than by `std::unique_ptr` so that
+  // they can be published with a compare-and-swap. The destructor doesn't
+  // release them, that's up to `clear`.
+  struct Handles {
+    std::array<
+        std::atomic<jsi::Function *>,
+        static_cast<size_t>(GlobalFunction::Count)>
+        functions{};
+  };
+
+  // Returns the handles of `rt` kept by the calling thread, or looks them up
+  // in `handles_` on a miss.
+  static Handles *getHandles(jsi::Runtime &rt);
+  static std::shared_ptr<Handles> lookupHandles(jsi::Runtime &rt);
+
+  // Drops all handles of `rt` without releasing them, used when `rt` is
+  // already being torn down.
+  static void forget(jsi::Runtime &rt);
+
+  static std::unique_ptr<jsi::Function> resolve(
+      jsi::Runtime &rt,
+      GlobalFunction function);
+
+  static std::unordered_map<jsi::Runtime *, std::shared_ptr<Handles>>
+      handles_;
+  // Protects `handles_`.
+  static std::mutex mutex_;
+  // Bumped whenever a runtime is torn down. The arrays kept by threads are
+  // only used while it's unchanged, as a new runtime could be allocated at
+  // the address of a destroyed one.
+  static std::atomic<uint64_t> generation_;
+
+  friend class WorkletRuntimeCollector;
+};
+
+} // namespace reanimated
@@ -0,0 +1,86 @@
+#include "PrecompiledWorkletBundle.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef ANDROID
+#include "Logger.h"
+#else
+#include "Common/cpp/hidden_headers/Logger.h"
+#endif
+
+namespace reanimated {
+
+class MappedFileBuffer : public jsi::Buffer {
+ public:
+  MappedFileBuffer(void *data, size_t size) : data_(data), size_(size) {}
+
+  ~MappedFileBuffer() {
+    munmap(data_, size_);
+  }
+
+  size_t size() const override {
+    return size_;
+  }
+
+  const uint8_t *data() const override {
+    return static_cast<const uint8_t *>(data_);
+  }
+
+ private:
+  void *const data_;
+  const size_t size_;
+};
+
+static std::shared_ptr<const jsi::Buffer> mapFile(const std::string &path) {
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd == -1) {
+    return nullptr;
+  }
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) == -1 || fileStat.st_size == 0) {
+    close(fd);
+    return nullptr;
+  }
+  auto size = static_cast<size_t>(fileStat.st_size);
+  void *data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // the mapping stays valid after the descriptor is closed
+  close(fd);
+  if (data == MAP_FAILED) {
+    return nullptr;
+  }
+  return std::make_shared<const MappedFileBuffer>(data, size);
+}
+
+std::string PrecompiledWorkletBundle::path_{};
+std::shared_ptr<const jsi::Buffer> PrecompiledWorkletBundle::buffer_{};
+bool PrecompiledWorkletBundle::isMapped_{false};
+std::mutex PrecompiledWorkletBundle::mutex_{};
+
+void PrecompiledWorkletBundle::setPath(const std::string &path) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  path_ = path;
+  buffer_ = nullptr;
+  isMapped_ = false;
+}
+
+std::shared_ptr<const jsi::Buffer> PrecompiledWorkletBundle::getBuffer() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (path_.empty()) {
+    return nullptr;
+  }
+  if (!isMapped_) {
+    buffer_ = mapFile(path_);
+    isMapped_ = true;
+    if (buffer_ == nullptr) {
+      Logger::log(("[Reanimated] Failed to map precompiled worklet bundle at " +
+                   path_ + ", worklets will be compiled at runtime instead.")
+                      .c_str());
+    }
+  }
+  return buffer_;
+}
+
+} // namespace reanimated
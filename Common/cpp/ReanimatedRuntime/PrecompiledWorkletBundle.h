@@ -0,0 +1,43 @@
+#pragma once
+
+#include <jsi/jsi.h>
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+using namespace facebook;
+
+namespace reanimated {
+
+// An opt-in bundle with the worklets of the app precompiled at build time
+// (e.g. to Hermes bytecode), built by `scripts/build-worklet-bundle.js`. Apps
+// ship it as `worklets.hbc`, a resource of the main bundle on iOS and an asset
+// on Android, from where the platform code sets its path before the worklet
+// runtimes are created. The file is memory-mapped once per process and
+// evaluated on the runtimes created with `usePrecompiledWorklets` (the UI
+// runtime and the ones that opt in), right after they are decorated and before
+// the value unpacker is installed.
+//
+// The bundle must only populate `global.__workletsCache` (a Map) with worklet
+// functions keyed by their `__workletHash`, creating it along with
+// `global.__handleCache` (a WeakMap) if it doesn't exist yet, the way the
+// value unpacker does. Worklets are keyed by the hash of their code, so ones
+// that don't match the code of the app are never used. It must not define
+// anything else, the value unpacker in particular always comes from the JS
+// bundle so that it can't get out of sync with it.
+class PrecompiledWorkletBundle {
+ public:
+  static void setPath(const std::string &path);
+
+  // Returns nullptr if no path was set or the file couldn't be mapped.
+  static std::shared_ptr<const jsi::Buffer> getBuffer();
+
+ private:
+  static std::string path_;
+  static std::shared_ptr<const jsi::Buffer> buffer_;
+  static bool isMapped_;
+  static std::mutex mutex_; // Protects `path_`, `buffer_` and `isMapped_`.
+};
+
+} // namespace reanimated
@@ -1,5 +1,7 @@
 #include "RNRuntimeDecorator.h"
+#include "ReanimatedJSIUtils.h"
 #include "ReanimatedVersion.h"
+#include "ShareableAllocator.h"
 
 namespace reanimated {
 
@@ -9,18 +11,56 @@ void RNRuntimeDecorator::decorate(
     const bool isReducedMotion) {
   rnRuntime.global().setProperty(rnRuntime, "_WORKLET", false);
 
-  jsi::Runtime &uiRuntime = nativeReanimatedModule->getUIRuntime();
-  auto workletRuntimeValue =
-      rnRuntime.global()
-          .getPropertyAsObject(rnRuntime, "ArrayBuffer")
-          .asFunction(rnRuntime)
-          .callAsConstructor(rnRuntime, {static_cast<double>(sizeof(void *))});
-  uintptr_t *workletRuntimeData = reinterpret_cast<uintptr_t *>(
-      workletRuntimeValue.getObject(rnRuntime).getArrayBuffer(rnRuntime).data(
-          rnRuntime));
-  workletRuntimeData[0] = reinterpret_cast<uintptr_t>(&uiRuntime);
-  rnRuntime.global().setProperty(
-      rnRuntime, "_WORKLET_RUNTIME", workletRuntimeValue);
+  // The UI runtime is created in the background, so its address is only
+  // read, possibly waiting for the runtime, once `_WORKLET_RUNTIME` is first
+  // accessed. The getter then replaces itself with the value.
+  auto defineProperty = rnRuntime.global()
+                            .getPropertyAsObject(rnRuntime, "Object")
+                            .getPropertyAsFunction(rnRuntime, "defineProperty");
+  auto workletRuntimeGetter = jsi::Function::createFromHostFunction(
+      rnRuntime,
+      jsi::PropNameID::forAscii(rnRuntime, "_WORKLET_RUNTIME"),
+      0,
+      [weakNativeReanimatedModule =
+           std::weak_ptr<NativeReanimatedModule>(nativeReanimatedModule)](
+          jsi::Runtime &rt,
+          const jsi::Value &,
+          const jsi::Value *,
+          size_t) -> jsi::Value {
+        auto nativeReanimatedModule = weakNativeReanimatedModule.lock();
+        if (nativeReanimatedModule == nullptr) {
+          return jsi::Value::undefined();
+        }
+        jsi::Runtime &uiRuntime = nativeReanimatedModule->getUIRuntime();
+        auto workletRuntimeValue =
+            rt.global()
+                .getPropertyAsObject(rt, "ArrayBuffer")
+                .asFunction(rt)
+                .callAsConstructor(rt, {static_cast<double>(sizeof(void *))});
+        uintptr_t *workletRuntimeData = reinterpret_cast<uintptr_t *>(
+            workletRuntimeValue.getObject(rt).getArrayBuffer(rt).data(rt));
+        workletRuntimeData[0] = reinterpret_cast<uintptr_t>(&uiRuntime);
+        jsi::Object descriptor(rt);
+        descriptor.setProperty(rt, "value", workletRuntimeValue);
+        descriptor.setProperty(rt, "writable", true);
+        descriptor.setProperty(rt, "enumerable", true);
+        descriptor.setProperty(rt, "configurable", true);
+        rt.global()
+            .getPropertyAsObject(rt, "Object")
+            .getPropertyAsFunction(rt, "defineProperty")
+            .call(rt, rt.global(), "_WORKLET_RUNTIME", descriptor);
+        return workletRuntimeValue;
+      });
+  jsi::Object workletRuntimeDescriptor(rnRuntime);
+  workletRuntimeDescriptor.setProperty(
+      rnRuntime, "get", workletRuntimeGetter);
+  workletRuntimeDescriptor.setProperty(rnRuntime, "enumerable", true);
+  workletRuntimeDescriptor.setProperty(rnRuntime, "configurable", true);
+  defineProperty.call(
+      rnRuntime,
+      rnRuntime.global(),
+      "_WORKLET_RUNTIME",
+      workletRuntimeDescriptor);
 
 #ifdef RCT_NEW_ARCH_ENABLED
   constexpr auto isFabric = true;
@@ -37,6 +77,21 @@ void RNRuntimeDecorator::decorate(
   rnRuntime.global().setProperty(
       rnRuntime, "_REANIMATED_IS_REDUCED_MOTION", isReducedMotion);
 
+  jsi_utils::installJsiFunction(
+      rnRuntime, "_getShareableAllocatorStats", [](jsi::Runtime &rt) {
+        auto stats = ShareableAllocator::getStats();
+        jsi::Object result(rt);
+        result.setProperty(
+            rt, "liveNodes", static_cast<double>(stats.liveNodes));
+        result.setProperty(
+            rt, "liveBytes", static_cast<double>(stats.liveBytes));
+        result.setProperty(
+            rt, "highWaterBytes", static_cast<double>(stats.highWaterBytes));
+        result.setProperty(
+            rt, "pooledBytes", static_cast<double>(stats.pooledBytes));
+        return result;
+      });
+
   rnRuntime.global().setProperty(
       rnRuntime,
       jsi::PropNameID::forAscii(rnRuntime, "__reanimatedModuleProxy"),
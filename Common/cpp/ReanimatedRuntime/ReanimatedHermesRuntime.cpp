@@ -75,19 +75,27 @@ class HermesExecutorRuntimeAdapter : public RuntimeAdapter {
 ReanimatedHermesRuntime::ReanimatedHermesRuntime(
     std::unique_ptr<facebook::hermes::HermesRuntime> runtime,
     const std::shared_ptr<MessageQueueThread> &jsQueue,
-    const std::string &name)
+    const std::string &name,
+    bool enableDebugger)
     : jsi::WithRuntimeDecorator<ReanimatedReentrancyCheck>(
           *runtime,
           reentrancyCheck_),
-      runtime_(std::move(runtime)) {
+      runtime_(std::move(runtime)),
+      isDebuggerEnabled_(enableDebugger) {
 #if HERMES_ENABLE_DEBUGGER
-  auto adapter =
-      std::make_unique<HermesExecutorRuntimeAdapter>(*runtime_, jsQueue);
+  if (isDebuggerEnabled_) {
+    auto adapter =
+        std::make_unique<HermesExecutorRuntimeAdapter>(*runtime_, jsQueue);
 #if REACT_NATIVE_MINOR_VERSION >= 71
-  debugToken_ = chrome::enableDebugging(std::move(adapter), name);
+    debugToken_ = chrome::enableDebugging(std::move(adapter), name);
 #else
-  chrome::enableDebugging(std::move(adapter), name);
+    chrome::enableDebugging(std::move(adapter), name);
 #endif // REACT_NATIVE_MINOR_VERSION
+  } else {
+    // The adapter quits the thread otherwise, see
+    // `~HermesExecutorRuntimeAdapter`.
+    jsQueue->quitSynchronous();
+  }
 #else
   // This is required by iOS, because there is an assertion in the destructor
   // that the thread was indeed `quit` before
@@ -126,6 +134,9 @@ ReanimatedHermesRuntime::ReanimatedHermesRuntime(
 
 ReanimatedHermesRuntime::~ReanimatedHermesRuntime() {
 #if HERMES_ENABLE_DEBUGGER
+  if (!isDebuggerEnabled_) {
+    return;
+  }
   // We have to disable debugging before the runtime is destroyed.
 #if REACT_NATIVE_MINOR_VERSION >= 71
   chrome::disableDebugging(debugToken_);
@@ -131,12 +131,14 @@ class ReanimatedHermesRuntime
   ReanimatedHermesRuntime(
       std::unique_ptr<facebook::hermes::HermesRuntime> runtime,
       const std::shared_ptr<MessageQueueThread> &jsQueue,
-      const std::string &name);
+      const std::string &name,
+      bool enableDebugger = true);
   ~ReanimatedHermesRuntime();
 
  private:
   std::unique_ptr<facebook::hermes::HermesRuntime> runtime_;
   ReanimatedReentrancyCheck reentrancyCheck_;
+  [[maybe_unused]] const bool isDebuggerEnabled_;
 #if HERMES_ENABLE_DEBUGGER
 #if REACT_NATIVE_MINOR_VERSION >= 71
   chrome::DebugSessionToken debugToken_;
@@ -26,24 +26,54 @@ using namespace react;
 std::shared_ptr<jsi::Runtime> ReanimatedRuntime::make(
     jsi::Runtime &rnRuntime,
     const std::shared_ptr<MessageQueueThread> &jsQueue,
-    const std::string &name) {
+    const std::string &name,
+    const RuntimeConfig &config) {
   (void)rnRuntime; // used only for V8
 #if JS_RUNTIME_HERMES
   // We don't call `jsQueue->quitSynchronous()` here, since it will be done
   // later in ReanimatedHermesRuntime
 
-  auto runtime = facebook::hermes::makeHermesRuntime();
+  auto gcConfigBuilder = ::hermes::vm::GCConfig::Builder();
+  if (config.initialHeapSize != 0) {
+    gcConfigBuilder.withInitHeapSize(
+        static_cast<::hermes::vm::gcheapsize_t>(config.initialHeapSize));
+  }
+  if (config.maxHeapSize != 0) {
+    gcConfigBuilder.withMaxHeapSize(
+        static_cast<::hermes::vm::gcheapsize_t>(config.maxHeapSize));
+  }
+  switch (config.gcMode) {
+    case RuntimeGCMode::Default:
+      break;
+    case RuntimeGCMode::Compact:
+      gcConfigBuilder.withShouldReleaseUnused(
+          ::hermes::vm::ReleaseUnused::kYoungAlways);
+      break;
+    case RuntimeGCMode::LowLatency:
+      gcConfigBuilder.withShouldReleaseUnused(
+          ::hermes::vm::ReleaseUnused::kNone);
+      break;
+  }
+  auto runtimeConfigBuilder =
+      ::hermes::vm::RuntimeConfig::Builder().withGCConfig(
+          gcConfigBuilder.withName(name).build());
+#if REACT_NATIVE_MINOR_VERSION >= 71
+  runtimeConfigBuilder.withMicrotaskQueue(config.enableMicrotasks);
+#endif // REACT_NATIVE_MINOR_VERSION
+
+  auto runtime =
+      facebook::hermes::makeHermesRuntime(runtimeConfigBuilder.build());
   return std::make_shared<ReanimatedHermesRuntime>(
-      std::move(runtime), jsQueue, name);
+      std::move(runtime), jsQueue, name, config.enableDebugger);
 #elif JS_RUNTIME_V8
   // This is required by iOS, because there is an assertion in the destructor
   // that the thread was indeed `quit` before.
   jsQueue->quitSynchronous();
 
-  auto config = std::make_unique<rnv8::V8RuntimeConfig>();
-  config->enableInspector = false;
-  config->appName = name;
-  return rnv8::createSharedV8Runtime(&rnRuntime, std::move(config));
+  auto v8Config = std::make_unique<rnv8::V8RuntimeConfig>();
+  v8Config->enableInspector = false;
+  v8Config->appName = name;
+  return rnv8::createSharedV8Runtime(&rnRuntime, std::move(v8Config));
 #else
   // This is required by iOS, because there is an assertion in the destructor
   // that the thread was indeed `quit` before
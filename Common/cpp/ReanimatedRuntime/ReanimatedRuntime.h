@@ -11,6 +11,7 @@
 #include <cxxreact/MessageQueueThread.h>
 #include <jsi/jsi.h>
 
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -19,12 +20,44 @@ namespace reanimated {
 using namespace facebook;
 using namespace react;
 
+enum class RuntimeGCMode {
+  // Whatever the engine does by default.
+  Default,
+  // Returns unused memory to the system after every young collection, which
+  // keeps the footprint of short-lived runtimes low at the cost of more work
+  // per collection.
+  Compact,
+  // Never spends time on returning unused memory to the system, which keeps
+  // collections as short as possible at the cost of a larger footprint.
+  LowLatency,
+};
+
+// Engine options of a runtime, currently only supported on Hermes and
+// ignored by other engines.
+struct RuntimeConfig {
+  // In bytes, 0 means the default of the engine.
+  uint64_t initialHeapSize = 0;
+  uint64_t maxHeapSize = 0;
+  RuntimeGCMode gcMode = RuntimeGCMode::Default;
+  // Enables the native microtask queue of the engine (`queueMicrotask` and
+  // promise jobs). The queue is drained after every worklet run with
+  // `WorkletRuntime::runGuarded`.
+  bool enableMicrotasks = false;
+  // Registers the runtime with the Chrome DevTools inspector in builds that
+  // support debugging.
+  bool enableDebugger = true;
+  // Evaluates the precompiled worklet bundle of the app, if there is one, see
+  // PrecompiledWorkletBundle.
+  bool usePrecompiledWorklets = false;
+};
+
 class ReanimatedRuntime {
  public:
   static std::shared_ptr<jsi::Runtime> make(
       jsi::Runtime &rnRuntime,
       const std::shared_ptr<MessageQueueThread> &jsQueue,
-      const std::string &name);
+      const std::string &name,
+      const RuntimeConfig &config = {});
 };
 
 } // namespace reanimated
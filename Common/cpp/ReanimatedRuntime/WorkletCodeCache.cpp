@@ -0,0 +1,23 @@
+#include "WorkletCodeCache.h"
+
+namespace reanimated {
+
+std::unordered_map<uint64_t, std::shared_ptr<const jsi::PreparedJavaScript>>
+    WorkletCodeCache::cache_{};
+std::mutex WorkletCodeCache::mutex_{};
+
+std::shared_ptr<const jsi::PreparedJavaScript> WorkletCodeCache::get(
+    uint64_t workletHash) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = cache_.find(workletHash);
+  return it != cache_.end() ? it->second : nullptr;
+}
+
+void WorkletCodeCache::set(
+    uint64_t workletHash,
+    const std::shared_ptr<const jsi::PreparedJavaScript> &preparedCode) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  cache_.emplace(workletHash, preparedCode);
+}
+
+} // namespace reanimated
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <jsi/jsi.h>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+using namespace facebook;
+
+namespace reanimated {
+
+// Keeps worklet code prepared for evaluation (Hermes bytecode when running on
+// Hermes) keyed by `__workletHash`, so that every worklet is compiled once per
+// process rather than once per worklet runtime. Prepared code is not tied to
+// the runtime it was prepared on and can be evaluated on any runtime of the
+// same engine, which holds for all worklet runtimes.
+class WorkletCodeCache {
+ public:
+  // Evaluates the code of the worklet with the given hash, preparing it first
+  // if this is the first time the worklet is seen in this process.
+  // `getCode` is only called in the latter case.
+  template <typename GetCode>
+  static jsi::Value evaluate(
+      jsi::Runtime &rt,
+      uint64_t workletHash,
+      GetCode &&getCode) {
+    auto preparedCode = get(workletHash);
+    if (preparedCode == nullptr) {
+      // We don't hold the lock while preparing the code, in the worst case
+      // the same worklet is compiled by two runtimes at the same time.
+      preparedCode = rt.prepareJavaScript(
+          std::make_shared<const jsi::StringBuffer>(getCode()),
+          "worklet_" + std::to_string(workletHash));
+      set(workletHash, preparedCode);
+    }
+    return rt.evaluatePreparedJavaScript(preparedCode);
+  }
+
+ private:
+  static std::shared_ptr<const jsi::PreparedJavaScript> get(
+      uint64_t workletHash);
+  static void set(
+      uint64_t workletHash,
+      const std::shared_ptr<const jsi::PreparedJavaScript> &preparedCode);
+
+  static std::unordered_map<
+      uint64_t,
+      std::shared_ptr<const jsi::PreparedJavaScript>>
+      cache_;
+  static std::mutex mutex_; // Protects `cache_`.
+};
+
+} // namespace reanimated
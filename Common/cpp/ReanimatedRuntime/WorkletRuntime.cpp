@@ -1,5 +1,7 @@
 #include "WorkletRuntime.h"
+#include "GlobalFunctionHandles.h"
 #include "JSISerializer.h"
+#include "PrecompiledWorkletBundle.h"
 #include "ReanimatedRuntime.h"
 #include "WorkletRuntimeCollector.h"
 #include "WorkletRuntimeDecorator.h"
@@ -9,18 +11,17 @@
 namespace reanimated {
 
 class AroundLock {
-  const std::shared_ptr<std::recursive_mutex> mutex_;
+  const std::shared_ptr<RuntimeLock> lock_;
 
  public:
-  explicit AroundLock(const std::shared_ptr<std::recursive_mutex> &mutex)
-      : mutex_(mutex) {}
+  explicit AroundLock(const std::shared_ptr<RuntimeLock> &lock) : lock_(lock) {}
 
   void before() const {
-    mutex_->lock();
+    lock_->lock();
   }
 
   void after() const {
-    mutex_->unlock();
+    lock_->unlock();
   }
 };
 
@@ -31,9 +32,9 @@ class LockableRuntime : public jsi::WithRuntimeDecorator<AroundLock> {
  public:
   explicit LockableRuntime(
       std::shared_ptr<jsi::Runtime> &runtime,
-      const std::shared_ptr<std::recursive_mutex> &runtimeMutex)
+      const std::shared_ptr<RuntimeLock> &runtimeLock)
       : jsi::WithRuntimeDecorator<AroundLock>(*runtime, aroundLock_),
-        aroundLock_(runtimeMutex),
+        aroundLock_(runtimeLock),
         runtime_(std::move(runtime)) {}
 };
 
@@ -42,10 +43,12 @@ static std::shared_ptr<jsi::Runtime> makeRuntime(
     const std::shared_ptr<MessageQueueThread> &jsQueue,
     const std::string &name,
     const bool supportsLocking,
-    const std::shared_ptr<std::recursive_mutex> &runtimeMutex) {
-  auto reanimatedRuntime = ReanimatedRuntime::make(runtime, jsQueue, name);
+    const std::shared_ptr<RuntimeLock> &runtimeLock,
+    const RuntimeConfig &runtimeConfig) {
+  auto reanimatedRuntime =
+      ReanimatedRuntime::make(runtime, jsQueue, name, runtimeConfig);
   if (supportsLocking) {
-    return std::make_shared<LockableRuntime>(reanimatedRuntime, runtimeMutex);
+    return std::make_shared<LockableRuntime>(reanimatedRuntime, runtimeLock);
   } else {
     return reanimatedRuntime;
   }
@@ -57,22 +60,31 @@ WorkletRuntime::WorkletRuntime(
     const std::shared_ptr<JSScheduler> &jsScheduler,
     const std::string &name,
     const bool supportsLocking,
-    const std::string &valueUnpackerCode)
-    : runtimeMutex_(std::make_shared<std::recursive_mutex>()),
+    const std::string &valueUnpackerCode,
+    const AsyncQueueConfig &queueConfig,
+    const RuntimeConfig &runtimeConfig)
+    : runtimeLock_(std::make_shared<RuntimeLock>()),
       runtime_(makeRuntime(
           rnRuntime,
           jsQueue,
           name,
           supportsLocking,
-          runtimeMutex_)),
-#ifndef NDEBUG
+          runtimeLock_,
+          runtimeConfig)),
       supportsLocking_(supportsLocking),
-#endif
-      name_(name) {
+      drainsMicrotasks_(runtimeConfig.enableMicrotasks),
+      name_(name),
+      queueConfig_(queueConfig) {
   jsi::Runtime &rt = *runtime_;
   WorkletRuntimeCollector::install(rt);
   WorkletRuntimeDecorator::decorate(rt, name, jsScheduler);
 
+  if (runtimeConfig.usePrecompiledWorklets) {
+    if (auto bundle = PrecompiledWorkletBundle::getBuffer()) {
+      rt.evaluateJavaScript(bundle, "PrecompiledWorkletBundle");
+    }
+  }
+
   auto codeBuffer = std::make_shared<const jsi::StringBuffer>(
       "(" + valueUnpackerCode + "\n)");
   auto valueUnpacker =
@@ -82,6 +94,13 @@ WorkletRuntime::WorkletRuntime(
   rt.global().setProperty(rt, "__valueUnpacker", valueUnpacker);
 }
 
+WorkletRuntime::~WorkletRuntime() {
+  // The runtime is still alive here, so its global function handles can be
+  // released properly instead of being leaked by WorkletRuntimeCollector.
+  auto lock = std::unique_lock<RuntimeLock>(*runtimeLock_);
+  GlobalFunctionHandles::clear(*runtime_);
+}
+
 jsi::Value WorkletRuntime::executeSync(
     jsi::Runtime &rt,
     const jsi::Value &worklet) const {
@@ -93,7 +112,33 @@ jsi::Value WorkletRuntime::executeSync(
       rt,
       worklet,
       "[Reanimated] Only worklets can be executed synchronously on UI runtime.");
-  auto lock = std::unique_lock<std::recursive_mutex>(*runtimeMutex_);
+  auto lock = std::unique_lock<RuntimeLock>(*runtimeLock_);
+  return runLocked(rt, shareableWorklet, lock);
+}
+
+std::optional<jsi::Value> WorkletRuntime::tryExecuteSync(
+    jsi::Runtime &rt,
+    const jsi::Value &worklet,
+    std::chrono::duration<double, std::milli> timeout) const {
+  assert(
+      supportsLocking_ &&
+      ("[Reanimated] Runtime \"" + name_ + "\" doesn't support locking.")
+          .c_str());
+  auto shareableWorklet = extractShareableOrThrow<ShareableWorklet>(
+      rt,
+      worklet,
+      "[Reanimated] Only worklets can be executed synchronously on UI runtime.");
+  auto lock = std::unique_lock<RuntimeLock>(*runtimeLock_, timeout);
+  if (!lock.owns_lock()) {
+    return std::nullopt;
+  }
+  return runLocked(rt, shareableWorklet, lock);
+}
+
+jsi::Value WorkletRuntime::runLocked(
+    jsi::Runtime &rt,
+    const std::shared_ptr<ShareableWorklet> &shareableWorklet,
+    std::unique_lock<RuntimeLock> &lock) const {
   jsi::Runtime &uiRuntime = getJSIRuntime();
   auto result = runGuarded(shareableWorklet);
   auto shareableResult = extractShareableOrThrow(uiRuntime, result);
@@ -101,6 +146,52 @@ jsi::Value WorkletRuntime::executeSync(
   return shareableResult->getJSValue(rt);
 }
 
+AsyncQueue &WorkletRuntime::getQueue() {
+  std::call_once(queueOnceFlag_, [this] {
+    queue_ = std::make_shared<AsyncQueue>(name_, queueConfig_);
+    hasQueue_.store(true, std::memory_order_release);
+  });
+  return *queue_;
+}
+
+jsi::Value WorkletRuntime::getQueueStats(jsi::Runtime &rt) {
+  // reading the stats doesn't start the thread of the queue
+  AsyncQueueStats stats;
+  if (hasQueue_.load(std::memory_order_acquire)) {
+    stats = queue_->getStats();
+  } else {
+    stats.capacity = queueConfig_.capacity;
+  }
+  jsi::Object result(rt);
+  result.setProperty(rt, "depth", static_cast<double>(stats.depth));
+  result.setProperty(rt, "maxDepth", static_cast<double>(stats.maxDepth));
+  result.setProperty(rt, "capacity", static_cast<double>(stats.capacity));
+  result.setProperty(rt, "processed", static_cast<double>(stats.processed));
+  result.setProperty(rt, "dropped", static_cast<double>(stats.dropped));
+  result.setProperty(rt, "merged", static_cast<double>(stats.merged));
+  result.setProperty(rt, "lastLatencyMs", stats.lastLatencyMs);
+  result.setProperty(rt, "averageLatencyMs", stats.averageLatencyMs);
+  return result;
+}
+
+jsi::Value WorkletRuntime::getLockStats(jsi::Runtime &rt) const {
+  auto stats = runtimeLock_->getStats();
+  jsi::Object result(rt);
+  result.setProperty(
+      rt, "acquisitions", static_cast<double>(stats.acquisitions));
+  result.setProperty(
+      rt,
+      "contendedAcquisitions",
+      static_cast<double>(stats.contendedAcquisitions));
+  result.setProperty(
+      rt,
+      "timedOutAcquisitions",
+      static_cast<double>(stats.timedOutAcquisitions));
+  result.setProperty(rt, "totalWaitMs", stats.totalWaitMs);
+  result.setProperty(rt, "longestHoldMs", stats.longestHoldMs);
+  return result;
+}
+
 jsi::Value WorkletRuntime::get(
     jsi::Runtime &rt,
     const jsi::PropNameID &propName) {
@@ -118,6 +209,10 @@ jsi::Value WorkletRuntime::get(
   if (name == "name") {
     return jsi::String::createFromUtf8(rt, name_);
   }
+  if (name == "queueStats") {
+    return getQueueStats(rt);
+  }
+
   return jsi::Value::undefined();
 }
 
@@ -126,6 +221,7 @@ std::vector<jsi::PropNameID> WorkletRuntime::getPropertyNames(
   std::vector<jsi::PropNameID> result;
   result.push_back(jsi::PropNameID::forUtf8(rt, "toString"));
   result.push_back(jsi::PropNameID::forUtf8(rt, "name"));
+  result.push_back(jsi::PropNameID::forUtf8(rt, "queueStats"));
   return result;
 }
 
@@ -138,13 +234,17 @@ std::shared_ptr<WorkletRuntime> extractWorkletRuntime(
 void scheduleOnRuntime(
     jsi::Runtime &rt,
     const jsi::Value &workletRuntimeValue,
-    const jsi::Value &shareableWorkletValue) {
+    const jsi::Value &shareableWorkletValue,
+    const jsi::Value &mergeKeyValue) {
   auto workletRuntime = extractWorkletRuntime(rt, workletRuntimeValue);
   auto shareableWorklet = extractShareableOrThrow<ShareableWorklet>(
       rt,
       shareableWorkletValue,
       "[Reanimated] Function passed to `_scheduleOnRuntime` is not a shareable worklet. Please make sure that `processNestedWorklets` option in Reanimated Babel plugin is enabled.");
-  workletRuntime->runAsyncGuarded(shareableWorklet);
+  auto mergeKey = mergeKeyValue.isNumber()
+      ? static_cast<uint64_t>(mergeKeyValue.asNumber())
+      : 0;
+  workletRuntime->runAsyncGuarded(shareableWorklet, mergeKey);
 }
 
 } // namespace reanimated
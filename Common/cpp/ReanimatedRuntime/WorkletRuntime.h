@@ -5,9 +5,17 @@
 
 #include "AsyncQueue.h"
 #include "JSScheduler.h"
+#include "ReanimatedRuntime.h"
+#include "RuntimeLock.h"
 #include "Shareables.h"
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <thread>
 #include <utility>
@@ -27,32 +35,84 @@ class WorkletRuntime : public jsi::HostObject,
       const std::shared_ptr<JSScheduler> &jsScheduler,
       const std::string &name,
       const bool supportsLocking,
-      const std::string &valueUnpackerCode);
+      const std::string &valueUnpackerCode,
+      const AsyncQueueConfig &queueConfig = {},
+      const RuntimeConfig &runtimeConfig = {});
+
+  ~WorkletRuntime();
 
   jsi::Runtime &getJSIRuntime() const {
     return *runtime_;
   }
 
+  // Locks the runtime if it supports locking. Code that makes many JSI calls
+  // in a row should hold it, so that the locks taken around each of the calls
+  // are recursive, which is the cheap path of RuntimeLock.
+  std::unique_lock<RuntimeLock> lock() const {
+    auto lock = std::unique_lock<RuntimeLock>(*runtimeLock_, std::defer_lock);
+    if (supportsLocking_) {
+      lock.lock();
+    }
+    return lock;
+  }
+
   template <typename... Args>
   inline jsi::Value runGuarded(
       const std::shared_ptr<ShareableWorklet> &shareableWorklet,
       Args &&...args) const {
     jsi::Runtime &rt = *runtime_;
-    return runOnRuntimeGuarded(
+    auto runtimeLock = lock();
+    auto result = runOnRuntimeGuarded(
         rt, shareableWorklet->getJSValue(rt), std::forward<Args>(args)...);
+    drainMicrotasks(rt);
+    return result;
   }
 
+  // Like `runGuarded`, but without the call guard, so that errors thrown by
+  // the worklet propagate to the caller instead of being reported.
+  template <typename... Args>
+  inline jsi::Value runUnguarded(
+      const std::shared_ptr<ShareableWorklet> &shareableWorklet,
+      Args &&...args) const {
+    jsi::Runtime &rt = *runtime_;
+    auto runtimeLock = lock();
+    auto result =
+        shareableWorklet->getJSValue(rt).asObject(rt).asFunction(rt).call(
+            rt, std::forward<Args>(args)...);
+    drainMicrotasks(rt);
+    return result;
+  }
+
+  // Jobs with the same non-zero `mergeKey` are merged when the queue of the
+  // runtime uses `AsyncQueueOverflowPolicy::Merge`.
   void runAsyncGuarded(
-      const std::shared_ptr<ShareableWorklet> &shareableWorklet) {
-    if (queue_ == nullptr) {
-      queue_ = std::make_shared<AsyncQueue>(name_);
-    }
-    queue_->push(
-        [=, self = shared_from_this()] { self->runGuarded(shareableWorklet); });
+      const std::shared_ptr<ShareableWorklet> &shareableWorklet,
+      uint64_t mergeKey = 0) {
+    getQueue().push(
+        [=, self = shared_from_this()] { self->runGuarded(shareableWorklet); },
+        mergeKey);
+  }
+
+  // Runs `job` on the queue of the runtime, see `runAsyncGuarded`. Returns
+  // false if the job was dropped because the queue is full.
+  bool runAsync(std::function<void()> &&job, uint64_t mergeKey = 0) {
+    return getQueue().push(std::move(job), mergeKey);
   }
 
   jsi::Value executeSync(jsi::Runtime &rt, const jsi::Value &worklet) const;
 
+  // Like `executeSync`, but gives up if the runtime can't be locked within
+  // `timeout`, in which case the worklet isn't run at all. A zero timeout
+  // only tries to lock the runtime once.
+  std::optional<jsi::Value> tryExecuteSync(
+      jsi::Runtime &rt,
+      const jsi::Value &worklet,
+      std::chrono::duration<double, std::milli> timeout) const;
+
+  // Contention statistics of the lock taken around the JSI calls of runtimes
+  // that support locking.
+  jsi::Value getLockStats(jsi::Runtime &rt) const;
+
   std::string toString() const {
     return "[WorkletRuntime \"" + name_ + "\"]";
   }
@@ -62,13 +122,36 @@ class WorkletRuntime : public jsi::HostObject,
   std::vector<jsi::PropNameID> getPropertyNames(jsi::Runtime &rt) override;
 
  private:
-  const std::shared_ptr<std::recursive_mutex> runtimeMutex_;
+  inline void drainMicrotasks(jsi::Runtime &rt) const {
+#if REACT_NATIVE_MINOR_VERSION >= 71
+    if (drainsMicrotasks_) {
+      rt.drainMicrotasks();
+    }
+#endif // REACT_NATIVE_MINOR_VERSION
+  }
+
+  AsyncQueue &getQueue();
+  jsi::Value getQueueStats(jsi::Runtime &rt);
+  // Runs the worklet on this runtime while `lock` is held and returns its
+  // result unpacked on `rt`, releasing the lock first.
+  jsi::Value runLocked(
+      jsi::Runtime &rt,
+      const std::shared_ptr<ShareableWorklet> &shareableWorklet,
+      std::unique_lock<RuntimeLock> &lock) const;
+
+  const std::shared_ptr<RuntimeLock> runtimeLock_;
   const std::shared_ptr<jsi::Runtime> runtime_;
-#ifndef NDEBUG
   const bool supportsLocking_;
-#endif
+  const bool drainsMicrotasks_;
   const std::string name_;
+  const AsyncQueueConfig queueConfig_;
+  // The queue and its thread are only created once the runtime is used
+  // asynchronously.
+  std::once_flag queueOnceFlag_;
   std::shared_ptr<AsyncQueue> queue_;
+  // Set once `queue_` is created, lets other threads read it without
+  // creating it.
+  std::atomic_bool hasQueue_{false};
 };
 
 // This function needs to be non-inline to avoid problems with dynamic_cast on
@@ -80,6 +163,7 @@ std::shared_ptr<WorkletRuntime> extractWorkletRuntime(
 void scheduleOnRuntime(
     jsi::Runtime &rt,
     const jsi::Value &workletRuntimeValue,
-    const jsi::Value &shareableWorkletValue);
+    const jsi::Value &shareableWorkletValue,
+    const jsi::Value &mergeKeyValue);
 
 } // namespace reanimated
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "GlobalFunctionHandles.h"
+#include "PropNameIDCache.h"
+#include "RuntimeValueCache.h"
 #include "WorkletRuntimeRegistry.h"
 
 #include <jsi/jsi.h>
@@ -12,7 +15,9 @@ class WorkletRuntimeCollector : public jsi::HostObject {
   // When worklet runtime is created, we inject an instance of this class as a
   // `jsi::HostObject` into the global object. When worklet runtime is
   // terminated, the object is garbage-collected, which runs the C++ destructor.
-  // In the destructor, we unregister the worklet runtime from the registry.
+  // In the destructor, we unregister the worklet runtime from the registry and
+  // drop the global function handles, property names and cached values that
+  // are still kept for it.
 
  public:
   explicit WorkletRuntimeCollector(jsi::Runtime &runtime) : runtime_(runtime) {
@@ -20,6 +25,9 @@ class WorkletRuntimeCollector : public jsi::HostObject {
   }
 
   ~WorkletRuntimeCollector() {
+    GlobalFunctionHandles::forget(runtime_);
+    PropNameIDCache::forget(runtime_);
+    RuntimeValueCache::forget(runtime_);
     WorkletRuntimeRegistry::unregisterRuntime(runtime_);
   }
 
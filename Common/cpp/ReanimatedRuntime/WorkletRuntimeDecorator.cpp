@@ -1,7 +1,9 @@
 #include "WorkletRuntimeDecorator.h"
 #include "JSISerializer.h"
 #include "ReanimatedJSIUtils.h"
+#include "RemoteCallArgs.h"
 #include "Shareables.h"
+#include "WorkletCodeCache.h"
 #include "WorkletRuntime.h"
 
 #ifdef ANDROID
@@ -41,6 +43,8 @@ void WorkletRuntimeDecorator::decorate(
 #endif // RCT_NEW_ARCH_ENABLED
   rt.global().setProperty(rt, "_IS_FABRIC", isFabric);
 
+  jsi_utils::LazyJsiFunctions functions;
+
 #ifndef NDEBUG
   auto evalWithSourceUrl = [](jsi::Runtime &rt,
                               const jsi::Value &thisValue,
@@ -54,78 +58,89 @@ void WorkletRuntimeDecorator::decorate(
     }
     return rt.evaluateJavaScript(code, url);
   };
-  rt.global().setProperty(
-      rt,
-      "evalWithSourceUrl",
-      jsi::Function::createFromHostFunction(
-          rt,
-          jsi::PropNameID::forAscii(rt, "evalWithSourceUrl"),
-          1,
-          evalWithSourceUrl));
+  functions.add("evalWithSourceUrl", 1, evalWithSourceUrl);
 #endif
 
-  jsi_utils::installJsiFunction(
-      rt, "_toString", [](jsi::Runtime &rt, const jsi::Value &value) {
-        return jsi::String::createFromUtf8(rt, stringifyJSIValue(rt, value));
-      });
-
-  jsi_utils::installJsiFunction(
-      rt, "_log", [](jsi::Runtime &rt, const jsi::Value &value) {
-        Logger::log(stringifyJSIValue(rt, value));
+  functions.add(
+      "_evalWithWorkletHash",
+      [](jsi::Runtime &rt,
+         const jsi::Value &code,
+         const jsi::Value &workletHash) {
+        return WorkletCodeCache::evaluate(
+            rt, static_cast<uint64_t>(workletHash.asNumber()), [&]() {
+              return code.asString(rt).utf8(rt);
+            });
       });
 
-  jsi_utils::installJsiFunction(
-      rt, "_makeShareableClone", [](jsi::Runtime &rt, const jsi::Value &value) {
-        auto shouldRetainRemote = jsi::Value::undefined();
-        return reanimated::makeShareableClone(rt, value, shouldRetainRemote);
-      });
+  functions.add("_toString", [](jsi::Runtime &rt, const jsi::Value &value) {
+    return jsi::String::createFromUtf8(rt, stringifyJSIValue(rt, value));
+  });
+
+  functions.add("_log", [](jsi::Runtime &rt, const jsi::Value &value) {
+    Logger::log(stringifyJSIValue(rt, value));
+  });
+
+  auto makeShareableClone = [](jsi::Runtime &rt,
+                               const jsi::Value &thisValue,
+                               const jsi::Value *args,
+                               size_t count) -> jsi::Value {
+    auto shouldRetainRemote = jsi::Value::undefined();
+    auto arrayBufferTransferMode = jsi::Value::undefined();
+    auto isTypedArray = count > 1 ? jsi::Value(rt, args[1]) : false;
+    return reanimated::makeShareableClone(
+        rt, args[0], shouldRetainRemote, arrayBufferTransferMode, isTypedArray);
+  };
+  functions.add("_makeShareableClone", 1, makeShareableClone);
 
-  jsi_utils::installJsiFunction(
-      rt,
+  functions.add(
       "_scheduleOnJS",
       [jsScheduler](
           jsi::Runtime &rt,
           const jsi::Value &remoteFun,
-          const jsi::Value &argsValue) {
+          const jsi::Value &argsValue,
+          const jsi::Value &coalesce) {
         auto shareableRemoteFun = extractShareableOrThrow<
             ShareableRemoteFunction>(
             rt,
             remoteFun,
             "[Reanimated] Incompatible object passed to scheduleOnJS. It is only allowed to schedule worklets or functions defined on the React Native JS runtime this way.");
-        auto shareableArgs = argsValue.isUndefined()
-            ? nullptr
-            : extractShareableOrThrow<ShareableArray>(
-                  rt, argsValue, "[Reanimated] Args must be an array.");
-        jsScheduler->scheduleOnJS([=](jsi::Runtime &rt) {
-          auto remoteFun = shareableRemoteFun->getJSValue(rt);
-          if (shareableArgs == nullptr) {
+        auto remoteArgs = RemoteCallArgs(rt, argsValue);
+        // calls of the same remote function replace each other until they
+        // are delivered, so that only the call with the latest args runs
+        auto coalescingKey = coalesce.isBool() && coalesce.getBool()
+            ? shareableRemoteFun.get()
+            : nullptr;
+        auto job = [shareableRemoteFun,
+                    remoteArgs = std::move(remoteArgs)](jsi::Runtime &rt) {
+          auto remoteFun =
+              shareableRemoteFun->getJSValue(rt).asObject(rt).asFunction(rt);
+          auto argsSize = remoteArgs.size();
+          if (argsSize == 0) {
             // fast path for remote function w/o arguments
-            remoteFun.asObject(rt).asFunction(rt).call(rt);
-          } else {
-            auto argsArray =
-                shareableArgs->getJSValue(rt).asObject(rt).asArray(rt);
-            auto argsSize = argsArray.size(rt);
-            // number of arguments is typically relatively small so it is ok to
-            // to use VLAs here, hence disabling the lint rule
-            jsi::Value args[argsSize]; // NOLINT(runtime/arrays)
-            for (size_t i = 0; i < argsSize; i++) {
-              args[i] = argsArray.getValueAtIndex(rt, i);
-            }
-            remoteFun.asObject(rt).asFunction(rt).call(rt, args, argsSize);
+            remoteFun.call(rt);
+            return;
           }
-        });
+          // number of arguments is typically relatively small so it is ok to
+          // to use VLAs here, hence disabling the lint rule
+          jsi::Value args[argsSize]; // NOLINT(runtime/arrays)
+          remoteArgs.materialize(rt, args);
+          remoteFun.call(rt, args, argsSize);
+        };
+        jsScheduler->scheduleOnJS(std::move(job), coalescingKey);
       });
 
-  jsi_utils::installJsiFunction(
-      rt,
+  functions.add(
       "_scheduleOnRuntime",
       [](jsi::Runtime &rt,
          const jsi::Value &workletRuntimeValue,
-         const jsi::Value &shareableWorkletValue) {
+         const jsi::Value &shareableWorkletValue,
+         const jsi::Value &mergeKeyValue) {
         reanimated::scheduleOnRuntime(
-            rt, workletRuntimeValue, shareableWorkletValue);
+            rt, workletRuntimeValue, shareableWorkletValue, mergeKeyValue);
       });
 
+  functions.install(rt);
+
   jsi::Object performance(rt);
   performance.setProperty(
       rt,
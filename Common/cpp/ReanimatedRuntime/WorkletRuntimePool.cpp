@@ -0,0 +1,344 @@
+#include "WorkletRuntimePool.h"
+
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+namespace reanimated {
+
+// Splits `parallelFor` into a few chunks per worker so that faster workers
+// can steal the remaining chunks from slower ones.
+static constexpr size_t kChunksPerWorker = 4;
+
+// Identifies the worker of the pool running on the current thread, so that
+// tasks scheduled from within a task end up in the deque of the same worker.
+static thread_local const void *currentPoolState = nullptr;
+static thread_local size_t currentWorkerIndex = 0;
+
+WorkletRuntimePool::WorkletRuntimePool(
+    jsi::Runtime &rnRuntime,
+    const std::shared_ptr<MessageQueueThread> &jsQueue,
+    const std::shared_ptr<JSScheduler> &jsScheduler,
+    const std::string &name,
+    size_t size,
+    const std::string &valueUnpackerCode,
+    const std::shared_ptr<ShareableWorklet> &initializer)
+    : rnRuntime_(rnRuntime),
+      jsScheduler_(jsScheduler),
+      name_(name),
+      state_(std::make_shared<State>()) {
+  state_->jsScheduler = jsScheduler;
+  for (size_t i = 0; i < size; i++) {
+    auto worker = std::make_unique<Worker>();
+    worker->workletRuntime = std::make_shared<WorkletRuntime>(
+        rnRuntime,
+        jsQueue,
+        jsScheduler,
+        name + " #" + std::to_string(i),
+        false /* supportsLocking */,
+        valueUnpackerCode);
+    worker->workletRuntime->runGuarded(initializer);
+    state_->workers.push_back(std::move(worker));
+  }
+  // the threads are started only once all the runtimes exist, as workers
+  // access each other's deques when stealing
+  for (size_t i = 0; i < size; i++) {
+    auto threadName = name + " #" + std::to_string(i);
+    auto thread = std::thread([state = state_, i, threadName] {
+#if __APPLE__
+      pthread_setname_np(threadName.c_str());
+#endif
+      runWorker(state, i);
+    });
+#ifdef ANDROID
+    pthread_setname_np(thread.native_handle(), threadName.c_str());
+#endif
+    thread.detach();
+  }
+}
+
+WorkletRuntimePool::~WorkletRuntimePool() {
+  {
+    std::lock_guard<std::mutex> lock(state_->sleepMutex);
+    state_->running = false;
+  }
+  state_->cv.notify_all();
+}
+
+void WorkletRuntimePool::runWorker(
+    const std::shared_ptr<State> &state,
+    size_t index) {
+  currentPoolState = state.get();
+  currentWorkerIndex = index;
+  auto &workletRuntime = *state->workers[index]->workletRuntime;
+  Task task;
+  while (state->running) {
+    if (takeTask(*state, index, task)) {
+      runTask(*state, task, workletRuntime);
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(state->sleepMutex);
+    state->cv.wait(lock, [&state] {
+      return state->pendingTasks != 0 || !state->running;
+    });
+  }
+  // drop the pending tasks here as they may hold shareables that unpacked
+  // values on this runtime
+  std::lock_guard<std::mutex> lock(state->workers[index]->tasksMutex);
+  state->workers[index]->tasks.clear();
+}
+
+void WorkletRuntimePool::runTask(
+    State &state,
+    Task &task,
+    WorkletRuntime &workletRuntime) {
+  // An exception must not escape the worker thread, as it's detached and
+  // that would terminate the app, so it's rethrown on the JS thread instead.
+  std::string error;
+  try {
+    task(workletRuntime);
+  } catch (const std::exception &e) {
+    error = e.what();
+  } catch (...) {
+    error = "[Reanimated] Unknown error in " + workletRuntime.toString() + ".";
+  }
+  task = nullptr;
+  if (!error.empty()) {
+    state.jsScheduler->scheduleOnJS([error](jsi::Runtime &rnRuntime) {
+      throw jsi::JSError(rnRuntime, error);
+    });
+  }
+}
+
+bool WorkletRuntimePool::takeTask(State &state, size_t index, Task &task) {
+  auto &workers = state.workers;
+  {
+    // the most recently pushed task of its own is likely to be the cheapest
+    // to run for a worker, e.g. a task scheduled by the previous one
+    auto &worker = *workers[index];
+    std::lock_guard<std::mutex> lock(worker.tasksMutex);
+    if (!worker.tasks.empty()) {
+      task = std::move(worker.tasks.back());
+      worker.tasks.pop_back();
+      state.pendingTasks--;
+      return true;
+    }
+  }
+  for (size_t i = 1; i < workers.size(); i++) {
+    auto &victim = *workers[(index + i) % workers.size()];
+    std::lock_guard<std::mutex> lock(victim.tasksMutex);
+    if (!victim.tasks.empty()) {
+      // steal the oldest task, the victim keeps working on the newest ones
+      task = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+      state.pendingTasks--;
+      return true;
+    }
+  }
+  return false;
+}
+
+void WorkletRuntimePool::push(Task &&task) {
+  auto &workers = state_->workers;
+  auto index = currentPoolState == state_.get()
+      ? currentWorkerIndex
+      : state_->nextWorker++ % workers.size();
+  {
+    // incremented under the lock so that a worker that is about to sleep
+    // can't miss it, and before the task is visible so that it never drops
+    // below zero when the task is taken right away
+    std::lock_guard<std::mutex> lock(state_->sleepMutex);
+    state_->pendingTasks++;
+  }
+  {
+    auto &worker = *workers[index];
+    std::lock_guard<std::mutex> lock(worker.tasksMutex);
+    worker.tasks.push_back(std::move(task));
+  }
+  state_->cv.notify_one();
+}
+
+void WorkletRuntimePool::schedule(
+    const std::shared_ptr<ShareableWorklet> &shareableWorklet) {
+  push([shareableWorklet](WorkletRuntime &workletRuntime) {
+    workletRuntime.runGuarded(shareableWorklet);
+  });
+}
+
+// Shared by the chunks of a `parallelFor`. The completion callback usually
+// holds values of the RN runtime, so it's only ever destroyed on the JS
+// thread: it's called there once the last chunk is done, or just released
+// there if the chunks are dropped, e.g. when the pool is torn down.
+class ParallelForCompletion {
+ public:
+  ParallelForCompletion(
+      const std::shared_ptr<JSScheduler> &jsScheduler,
+      JSScheduler::Job &&onComplete,
+      size_t chunks)
+      : jsScheduler_(jsScheduler),
+        onComplete_(std::move(onComplete)),
+        remainingChunks_(chunks) {}
+
+  ~ParallelForCompletion() {
+    if (onComplete_ != nullptr) {
+      jsScheduler_->scheduleOnJS(
+          [onComplete = std::move(onComplete_)](jsi::Runtime &) {});
+    }
+  }
+
+  void chunkDone() {
+    if (--remainingChunks_ == 0 && onComplete_ != nullptr) {
+      jsScheduler_->scheduleOnJS(std::move(onComplete_));
+      onComplete_ = nullptr;
+    }
+  }
+
+ private:
+  const std::shared_ptr<JSScheduler> jsScheduler_;
+  // Only accessed by the last chunk, or by the destructor after that.
+  JSScheduler::Job onComplete_;
+  std::atomic<size_t> remainingChunks_;
+};
+
+void WorkletRuntimePool::parallelFor(
+    size_t count,
+    const std::shared_ptr<ShareableWorklet> &shareableWorklet,
+    std::function<void(jsi::Runtime &rnRuntime)> &&onComplete) {
+  if (count == 0) {
+    if (onComplete != nullptr) {
+      jsScheduler_->scheduleOnJS(std::move(onComplete));
+    }
+    return;
+  }
+  auto chunks = std::min(count, state_->workers.size() * kChunksPerWorker);
+  auto chunkSize = (count + chunks - 1) / chunks;
+  chunks = (count + chunkSize - 1) / chunkSize;
+  auto completion = std::make_shared<ParallelForCompletion>(
+      jsScheduler_, std::move(onComplete), chunks);
+  for (size_t begin = 0; begin < count; begin += chunkSize) {
+    auto end = std::min(begin + chunkSize, count);
+    push([=](WorkletRuntime &workletRuntime) {
+      // counts the chunk as done even if a call throws, so that
+      // `onComplete` is still called
+      struct ChunkGuard {
+        ~ChunkGuard() {
+          completion->chunkDone();
+        }
+        ParallelForCompletion *completion;
+      } chunkGuard{completion.get()};
+      for (auto i = begin; i < end; i++) {
+        workletRuntime.runGuarded(
+            shareableWorklet, jsi::Value(static_cast<double>(i)));
+      }
+    });
+  }
+}
+
+// Host functions of the pool may outlive it, e.g. when they are kept by JS
+// code after the pool was garbage collected.
+static std::shared_ptr<WorkletRuntimePool> lockOrThrow(
+    const std::weak_ptr<WorkletRuntimePool> &weakPool) {
+  auto pool = weakPool.lock();
+  if (pool == nullptr) {
+    throw std::runtime_error(
+        "[Reanimated] Worklet runtime pool has already been destroyed.");
+  }
+  return pool;
+}
+
+jsi::Value WorkletRuntimePool::get(
+    jsi::Runtime &rt,
+    const jsi::PropNameID &propName) {
+  auto name = propName.utf8(rt);
+  if (name == "toString") {
+    return jsi::Function::createFromHostFunction(
+        rt,
+        propName,
+        0,
+        [description = toString()](
+            jsi::Runtime &rt, const jsi::Value &, const jsi::Value *, size_t)
+            -> jsi::Value {
+          return jsi::String::createFromUtf8(rt, description);
+        });
+  }
+  if (name == "name") {
+    return jsi::String::createFromUtf8(rt, name_);
+  }
+  if (name == "size") {
+    return jsi::Value(static_cast<double>(state_->workers.size()));
+  }
+  if (name == "schedule") {
+    return jsi::Function::createFromHostFunction(
+        rt,
+        propName,
+        1,
+        [weakThis = weak_from_this()](
+            jsi::Runtime &rt,
+            const jsi::Value &,
+            const jsi::Value *args,
+            size_t count) -> jsi::Value {
+          auto pool = lockOrThrow(weakThis);
+          if (count < 1) {
+            throw std::runtime_error(
+                "[Reanimated] `schedule` expects a worklet.");
+          }
+          pool->schedule(extractShareableOrThrow<ShareableWorklet>(
+              rt,
+              args[0],
+              "[Reanimated] Only worklets can be scheduled on a worklet runtime pool."));
+          return jsi::Value::undefined();
+        });
+  }
+  if (name == "parallelFor") {
+    return jsi::Function::createFromHostFunction(
+        rt,
+        propName,
+        3,
+        [weakThis = weak_from_this()](
+            jsi::Runtime &rt,
+            const jsi::Value &,
+            const jsi::Value *args,
+            size_t count) -> jsi::Value {
+          auto pool = lockOrThrow(weakThis);
+          if (count < 2 || !args[0].isNumber() || args[0].asNumber() < 0) {
+            throw std::runtime_error(
+                "[Reanimated] `parallelFor` expects a non-negative count and a worklet.");
+          }
+          auto shareableWorklet = extractShareableOrThrow<ShareableWorklet>(
+              rt,
+              args[1],
+              "[Reanimated] Only worklets can be scheduled on a worklet runtime pool.");
+          std::function<void(jsi::Runtime &)> onComplete;
+          if (count > 2 && !args[2].isUndefined()) {
+            if (&rt != &pool->rnRuntime_) {
+              throw std::runtime_error(
+                  "[Reanimated] `parallelFor` completion callbacks are only supported on the React Native runtime.");
+            }
+            auto callback = std::make_shared<jsi::Function>(
+                args[2].asObject(rt).asFunction(rt));
+            onComplete = [callback](jsi::Runtime &rnRuntime) {
+              callback->call(rnRuntime);
+            };
+          }
+          pool->parallelFor(
+              static_cast<size_t>(args[0].asNumber()),
+              shareableWorklet,
+              std::move(onComplete));
+          return jsi::Value::undefined();
+        });
+  }
+  return jsi::Value::undefined();
+}
+
+std::vector<jsi::PropNameID> WorkletRuntimePool::getPropertyNames(
+    jsi::Runtime &rt) {
+  std::vector<jsi::PropNameID> result;
+  result.push_back(jsi::PropNameID::forUtf8(rt, "toString"));
+  result.push_back(jsi::PropNameID::forUtf8(rt, "name"));
+  result.push_back(jsi::PropNameID::forUtf8(rt, "size"));
+  result.push_back(jsi::PropNameID::forUtf8(rt, "schedule"));
+  result.push_back(jsi::PropNameID::forUtf8(rt, "parallelFor"));
+  return result;
+}
+
+} // namespace reanimated
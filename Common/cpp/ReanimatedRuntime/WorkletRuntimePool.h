@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cxxreact/MessageQueueThread.h>
+#include <jsi/jsi.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "JSScheduler.h"
+#include "Shareables.h"
+#include "WorkletRuntime.h"
+
+using namespace facebook;
+using namespace react;
+
+namespace reanimated {
+
+// A fixed number of worklet runtimes, each running on its own thread, that
+// share a work-stealing scheduler. Every worker takes tasks from its own deque
+// first and steals from the other workers once it runs out, so that
+// CPU-heavy worklets scale across cores. A task may run on any of the
+// runtimes, hence worklets scheduled on a pool shouldn't rely on the global
+// state of a particular runtime other than what `initializer` sets up.
+class WorkletRuntimePool
+    : public jsi::HostObject,
+      public std::enable_shared_from_this<WorkletRuntimePool> {
+ public:
+  using Task = std::function<void(WorkletRuntime &workletRuntime)>;
+
+  WorkletRuntimePool(
+      jsi::Runtime &rnRuntime,
+      const std::shared_ptr<MessageQueueThread> &jsQueue,
+      const std::shared_ptr<JSScheduler> &jsScheduler,
+      const std::string &name,
+      size_t size,
+      const std::string &valueUnpackerCode,
+      const std::shared_ptr<ShareableWorklet> &initializer);
+
+  ~WorkletRuntimePool();
+
+  void schedule(const std::shared_ptr<ShareableWorklet> &shareableWorklet);
+
+  // Calls the worklet with every index in [0, count), split into chunks that
+  // are spread over the workers. `onComplete` is called on the JS thread once
+  // all the calls are done.
+  void parallelFor(
+      size_t count,
+      const std::shared_ptr<ShareableWorklet> &shareableWorklet,
+      std::function<void(jsi::Runtime &rnRuntime)> &&onComplete = nullptr);
+
+  std::string toString() const {
+    return "[WorkletRuntimePool \"" + name_ + "\"]";
+  }
+
+  jsi::Value get(jsi::Runtime &rt, const jsi::PropNameID &propName) override;
+
+  std::vector<jsi::PropNameID> getPropertyNames(jsi::Runtime &rt) override;
+
+ private:
+  struct Worker {
+    std::shared_ptr<WorkletRuntime> workletRuntime;
+    std::mutex tasksMutex; // Protects `tasks`.
+    std::deque<Task> tasks;
+  };
+
+  // Shared with the worker threads, which outlive the pool if they are still
+  // running a task when it's destroyed.
+  struct State {
+    // Errors thrown by tasks are rethrown on the JS thread.
+    std::shared_ptr<JSScheduler> jsScheduler;
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic_bool running{true};
+    std::mutex sleepMutex;
+    std::condition_variable cv;
+    // Number of tasks that are queued but not yet taken by any worker.
+    std::atomic<size_t> pendingTasks{0};
+    std::atomic<size_t> nextWorker{0};
+  };
+
+  static void runWorker(const std::shared_ptr<State> &state, size_t index);
+  static bool takeTask(State &state, size_t index, Task &task);
+  static void runTask(State &state, Task &task, WorkletRuntime &workletRuntime);
+
+  void push(Task &&task);
+
+  jsi::Runtime &rnRuntime_;
+  const std::shared_ptr<JSScheduler> jsScheduler_;
+  const std::string name_;
+  const std::shared_ptr<State> state_;
+};
+
+} // namespace reanimated
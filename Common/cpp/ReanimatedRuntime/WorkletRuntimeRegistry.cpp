@@ -2,7 +2,8 @@
 
 namespace reanimated {
 
-std::set<jsi::Runtime *> WorkletRuntimeRegistry::registry_{};
+std::map<jsi::Runtime *, uint64_t> WorkletRuntimeRegistry::registry_{};
+uint64_t WorkletRuntimeRegistry::nextGeneration_{1};
 std::mutex WorkletRuntimeRegistry::mutex_{};
 
 } // namespace reanimated
@@ -2,8 +2,9 @@
 
 #include <jsi/jsi.h>
 
+#include <cstdint>
+#include <map>
 #include <mutex>
-#include <set>
 
 using namespace facebook;
 
@@ -11,14 +12,18 @@ namespace reanimated {
 
 class WorkletRuntimeRegistry {
  private:
-  static std::set<jsi::Runtime *> registry_;
-  static std::mutex mutex_; // Protects `registry_`.
+  // Maps every alive runtime to its generation, a number that uniquely
+  // identifies the registration. It allows us to tell apart two runtimes that
+  // happened to be allocated at the same address.
+  static std::map<jsi::Runtime *, uint64_t> registry_;
+  static uint64_t nextGeneration_;
+  static std::mutex mutex_; // Protects `registry_` and `nextGeneration_`.
 
   WorkletRuntimeRegistry() {} // private ctor
 
   static void registerRuntime(jsi::Runtime &runtime) {
     std::lock_guard<std::mutex> lock(mutex_);
-    registry_.insert(&runtime);
+    registry_[&runtime] = nextGeneration_++;
   }
 
   static void unregisterRuntime(jsi::Runtime &runtime) {
@@ -34,6 +39,14 @@ class WorkletRuntimeRegistry {
     std::lock_guard<std::mutex> lock(mutex_);
     return registry_.find(runtime) != registry_.end();
   }
+
+  // Returns the generation of `runtime` or 0 if the runtime is not alive.
+  static uint64_t getRuntimeGeneration(jsi::Runtime *runtime) {
+    assert(runtime != nullptr);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = registry_.find(runtime);
+    return it == registry_.end() ? 0 : it->second;
+  }
 };
 
 } // namespace reanimated
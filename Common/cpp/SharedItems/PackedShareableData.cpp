@@ -0,0 +1,298 @@
+#include "PackedShareableData.h"
+
+#include <cassert>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace reanimated {
+
+template <typename T>
+static inline T readRaw(const uint8_t *&cursor) {
+  T value;
+  memcpy(&value, cursor, sizeof(T));
+  cursor += sizeof(T);
+  return value;
+}
+
+template <typename T>
+static inline void writeRaw(std::vector<uint8_t> &stream, T value) {
+  auto offset = stream.size();
+  stream.resize(offset + sizeof(T));
+  memcpy(stream.data() + offset, &value, sizeof(T));
+}
+
+void PackedShareableData::Builder::addTag(Tag tag) {
+  stream_.push_back(static_cast<uint8_t>(tag));
+}
+
+void PackedShareableData::Builder::addUint32(uint32_t value) {
+  writeRaw(stream_, value);
+}
+
+uint32_t PackedShareableData::Builder::internString(std::string_view value) {
+  assert(
+      value.size() <= std::numeric_limits<uint32_t>::max() &&
+      "[Reanimated] String is too long to be packed.");
+  auto it = stringOffsets_.find(value);
+  if (it != stringOffsets_.end()) {
+    return it->second;
+  }
+  auto offset = static_cast<uint32_t>(strings_.size());
+  strings_.append(value);
+  stringOffsets_.emplace(value, offset);
+  return offset;
+}
+
+void PackedShareableData::Builder::addUndefined() {
+  addTag(Tag::Undefined);
+}
+
+void PackedShareableData::Builder::addNull() {
+  addTag(Tag::Null);
+}
+
+void PackedShareableData::Builder::addBoolean(bool value) {
+  addTag(value ? Tag::True : Tag::False);
+}
+
+void PackedShareableData::Builder::addNumber(double value) {
+  addTag(Tag::Number);
+  writeRaw(stream_, value);
+}
+
+void PackedShareableData::Builder::addString(std::string_view value) {
+  addTag(Tag::String);
+  addUint32(internString(value));
+  addUint32(static_cast<uint32_t>(value.size()));
+}
+
+void PackedShareableData::Builder::beginArray(size_t size) {
+  addTag(Tag::Array);
+  addUint32(static_cast<uint32_t>(size));
+}
+
+void PackedShareableData::Builder::beginObject(size_t size) {
+  addTag(Tag::Object);
+  addUint32(static_cast<uint32_t>(size));
+}
+
+void PackedShareableData::Builder::addKey(std::string_view key) {
+  auto it = keyIndices_.find(key);
+  if (it != keyIndices_.end()) {
+    addUint32(it->second);
+    return;
+  }
+  auto index = static_cast<uint32_t>(keyIndices_.size());
+  writeRaw(keys_, internString(key));
+  writeRaw(keys_, static_cast<uint32_t>(key.size()));
+  keyIndices_.emplace(key, index);
+  addUint32(index);
+}
+
+std::string_view PackedShareableData::Builder::ownString(std::string &&value) {
+  return ownedStrings_.emplace_back(std::move(value));
+}
+
+void PackedShareableData::Builder::addJSValue(
+    jsi::Runtime &rt,
+    const jsi::Value &value) {
+  if (value.isUndefined()) {
+    addUndefined();
+  } else if (value.isNull()) {
+    addNull();
+  } else if (value.isBool()) {
+    addBoolean(value.getBool());
+  } else if (value.isNumber()) {
+    addNumber(value.getNumber());
+  } else if (value.isString()) {
+    addString(ownString(value.getString(rt).utf8(rt)));
+  } else if (value.isObject()) {
+    auto object = value.getObject(rt);
+    if (object.isFunction(rt) || object.isHostObject(rt) ||
+        object.isArrayBuffer(rt)) {
+      throw std::runtime_error(
+          "[Reanimated] Attempted to pack an object that is not plain data.");
+    }
+    if (object.isArray(rt)) {
+      auto array = object.getArray(rt);
+      auto size = array.size(rt);
+      beginArray(size);
+      for (size_t i = 0; i < size; i++) {
+        addJSValue(rt, array.getValueAtIndex(rt, i));
+      }
+      return;
+    }
+    auto propertyNames = object.getPropertyNames(rt);
+    auto size = propertyNames.size(rt);
+    beginObject(size);
+    for (size_t i = 0; i < size; i++) {
+      auto key = propertyNames.getValueAtIndex(rt, i).getString(rt);
+      addKey(ownString(key.utf8(rt)));
+      addJSValue(rt, object.getProperty(rt, key));
+    }
+  } else {
+    throw std::runtime_error(
+        "[Reanimated] Attempted to pack a value that is not plain data.");
+  }
+}
+
+// Data built with deduplication enabled, looked up by the hash of its arena.
+// Expired entries are removed by the destructor of the data. Intentionally
+// leaked, as shareables may be released after static destructors have run.
+static std::mutex deduplicatedDataMutex;
+static auto *const deduplicatedData = new std::
+    unordered_multimap<size_t, std::weak_ptr<const PackedShareableData>>();
+
+static size_t hashArena(const std::vector<uint8_t> &arena) {
+  // FNV-1a
+  uint64_t hash = 14695981039346656037ull;
+  for (auto byte : arena) {
+    hash = (hash ^ byte) * 1099511628211ull;
+  }
+  return static_cast<size_t>(hash);
+}
+
+std::shared_ptr<const PackedShareableData> PackedShareableData::Builder::build(
+    bool deduplicate) {
+  auto keysOffset = stream_.size();
+  auto stringsOffset = keysOffset + keys_.size();
+  std::vector<uint8_t> arena;
+  arena.reserve(stringsOffset + strings_.size());
+  arena.insert(arena.end(), stream_.begin(), stream_.end());
+  arena.insert(arena.end(), keys_.begin(), keys_.end());
+  arena.insert(arena.end(), strings_.begin(), strings_.end());
+  stringOffsets_.clear();
+  keyIndices_.clear();
+  stream_.clear();
+  keys_.clear();
+  strings_.clear();
+  ownedStrings_.clear();
+  if (!deduplicate) {
+    return std::shared_ptr<const PackedShareableData>(new PackedShareableData(
+        std::move(arena), keysOffset, stringsOffset, false, 0));
+  }
+  auto hash = hashArena(arena);
+  // Candidates are kept alive until the lock is released, as releasing the
+  // last reference to any of them would call into the destructor that takes
+  // the lock as well.
+  std::vector<std::shared_ptr<const PackedShareableData>> candidates;
+  std::lock_guard<std::mutex> lock(deduplicatedDataMutex);
+  auto range = deduplicatedData->equal_range(hash);
+  for (auto it = range.first; it != range.second; it++) {
+    auto candidate = it->second.lock();
+    if (candidate == nullptr) {
+      continue;
+    }
+    candidates.push_back(candidate);
+    if (candidate->keysOffset_ == keysOffset && candidate->arena_ == arena) {
+      return candidate;
+    }
+  }
+  auto data =
+      std::shared_ptr<const PackedShareableData>(new PackedShareableData(
+          std::move(arena), keysOffset, stringsOffset, true, hash));
+  deduplicatedData->emplace(hash, data);
+  return data;
+}
+
+PackedShareableData::~PackedShareableData() {
+  if (!isDeduplicated_) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(deduplicatedDataMutex);
+  auto range = deduplicatedData->equal_range(hash_);
+  for (auto it = range.first; it != range.second;) {
+    it = it->second.expired() ? deduplicatedData->erase(it) : std::next(it);
+  }
+}
+
+std::string_view PackedShareableData::readString(
+    const uint8_t *&cursor) const {
+  auto offset = readRaw<uint32_t>(cursor);
+  auto length = readRaw<uint32_t>(cursor);
+  return std::string_view(
+      reinterpret_cast<const char *>(begin() + stringsOffset_ + offset),
+      length);
+}
+
+std::string_view PackedShareableData::getKey(uint32_t index) const {
+  const uint8_t *cursor = begin() + keysOffset_ + index * 2 * sizeof(uint32_t);
+  return readString(cursor);
+}
+
+jsi::Value PackedShareableData::readValue(
+    jsi::Runtime &rt,
+    const uint8_t *&cursor,
+    const std::vector<jsi::PropNameID> *propNames) const {
+  auto tag = static_cast<Tag>(*cursor++);
+  switch (tag) {
+    case Tag::Undefined:
+      return jsi::Value::undefined();
+    case Tag::Null:
+      return jsi::Value::null();
+    case Tag::False:
+      return jsi::Value(false);
+    case Tag::True:
+      return jsi::Value(true);
+    case Tag::Number:
+      return jsi::Value(readRaw<double>(cursor));
+    case Tag::String: {
+      auto string = readString(cursor);
+      return jsi::String::createFromUtf8(
+          rt, reinterpret_cast<const uint8_t *>(string.data()), string.size());
+    }
+    case Tag::Array: {
+      auto size = readRaw<uint32_t>(cursor);
+      auto array = jsi::Array(rt, size);
+      for (uint32_t i = 0; i < size; i++) {
+        array.setValueAtIndex(rt, i, readValue(rt, cursor, propNames));
+      }
+      return array;
+    }
+    case Tag::Object: {
+      auto size = readRaw<uint32_t>(cursor);
+      auto object = jsi::Object(rt);
+      for (uint32_t i = 0; i < size; i++) {
+        auto keyIndex = readRaw<uint32_t>(cursor);
+        if (propNames != nullptr) {
+          object.setProperty(
+              rt, (*propNames)[keyIndex], readValue(rt, cursor, propNames));
+        } else {
+          auto key = getKey(keyIndex);
+          auto propName = jsi::PropNameID::forUtf8(
+              rt, reinterpret_cast<const uint8_t *>(key.data()), key.size());
+          object.setProperty(rt, propName, readValue(rt, cursor, propNames));
+        }
+      }
+      return object;
+    }
+  }
+  throw std::runtime_error(
+      "[Reanimated] Encountered an unknown tag in packed shareable data.");
+}
+
+jsi::Value PackedShareableData::toJSValue(jsi::Runtime &rt) const {
+  if (isDeduplicated_) {
+    return valueCache_.get(rt, [&]() { return makeJSValue(rt); });
+  }
+  return makeJSValue(rt);
+}
+
+jsi::Value PackedShareableData::makeJSValue(jsi::Runtime &rt) const {
+  auto propNames = propNameIDCache_.get(rt, keyCount(), [&](size_t i) {
+    auto key = getKey(static_cast<uint32_t>(i));
+    return jsi::PropNameID::forUtf8(
+        rt, reinterpret_cast<const uint8_t *>(key.data()), key.size());
+  });
+  const uint8_t *cursor = begin();
+  return readValue(rt, cursor, propNames);
+}
+
+} // namespace reanimated
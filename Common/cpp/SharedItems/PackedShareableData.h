@@ -0,0 +1,139 @@
+#pragma once
+
+#include <jsi/jsi.h>
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "PropNameIDCache.h"
+#include "RuntimeValueCache.h"
+
+using namespace facebook;
+
+namespace reanimated {
+
+// PackedShareableData is a flat, pointer-free encoding of a plain-data tree
+// (objects, arrays, strings and scalars). Instead of keeping a separate
+// `Shareable` node for every nested value and a `std::string` copy for every
+// key, the whole tree is stored in a single contiguous arena that consists of
+// a tagged value stream, a key table and a string table. Strings are
+// deduplicated and referenced by their offset and length in the string table.
+// Object keys are deduplicated as well and referenced by their index in the key
+// table, so that their property names can be cached per runtime.
+//
+// Stream layout (all integers are stored in the native byte order as the data
+// never leaves the process):
+//   Undefined | Null | False | True -> [tag]
+//   Number                          -> [tag][double]
+//   String                          -> [tag][u32 offset][u32 length]
+//   Array                           -> [tag][u32 size] value*
+//   Object                          -> [tag][u32 size] ([u32 key index] value)*
+// Key table layout:
+//   ([u32 offset][u32 length])*
+//
+// Data built with deduplication enabled is content-addressed: building a tree
+// identical to one that is still alive returns the existing instance instead.
+// Such data is treated as immutable and the JS value it materializes to is
+// cached per runtime, so all its users receive the very same JS object.
+class PackedShareableData {
+ public:
+  enum class Tag : uint8_t {
+    Undefined,
+    Null,
+    False,
+    True,
+    Number,
+    String,
+    Array,
+    Object,
+  };
+
+  class Builder {
+   public:
+    void addUndefined();
+    void addNull();
+    void addBoolean(bool value);
+    void addNumber(double value);
+    // The memory `value` points to must stay alive until `build` is called.
+    void addString(std::string_view value);
+    // Must be followed by `size` values.
+    void beginArray(size_t size);
+    // Must be followed by `size` pairs of `addKey` and a value.
+    void beginObject(size_t size);
+    // The memory `key` points to must stay alive until `build` is called.
+    void addKey(std::string_view key);
+    // Walks a tree of plain objects, arrays and primitives and adds it as a
+    // single value. Throws on anything else, e.g. functions or host objects.
+    void addJSValue(jsi::Runtime &rt, const jsi::Value &value);
+
+    std::shared_ptr<const PackedShareableData> build(bool deduplicate = false);
+
+   private:
+    void addTag(Tag tag);
+    void addUint32(uint32_t value);
+    uint32_t internString(std::string_view value);
+    std::string_view ownString(std::string &&value);
+
+    std::vector<uint8_t> stream_;
+    std::vector<uint8_t> keys_;
+    std::string strings_;
+    std::unordered_map<std::string_view, uint32_t> stringOffsets_;
+    std::unordered_map<std::string_view, uint32_t> keyIndices_;
+    // Strings read from a runtime by `addJSValue`, kept alive until `build`.
+    // A deque, as it never moves its elements.
+    std::deque<std::string> ownedStrings_;
+  };
+
+  ~PackedShareableData();
+
+  jsi::Value toJSValue(jsi::Runtime &rt) const;
+
+  inline size_t size() const {
+    return arena_.size();
+  }
+
+ private:
+  PackedShareableData(
+      std::vector<uint8_t> &&arena,
+      size_t keysOffset,
+      size_t stringsOffset,
+      bool isDeduplicated,
+      size_t hash)
+      : arena_(std::move(arena)),
+        keysOffset_(keysOffset),
+        stringsOffset_(stringsOffset),
+        isDeduplicated_(isDeduplicated),
+        hash_(hash) {}
+
+  jsi::Value makeJSValue(jsi::Runtime &rt) const;
+  jsi::Value readValue(
+      jsi::Runtime &rt,
+      const uint8_t *&cursor,
+      const std::vector<jsi::PropNameID> *propNames) const;
+  std::string_view readString(const uint8_t *&cursor) const;
+  std::string_view getKey(uint32_t index) const;
+
+  inline const uint8_t *begin() const {
+    return arena_.data();
+  }
+
+  inline size_t keyCount() const {
+    return (stringsOffset_ - keysOffset_) / (2 * sizeof(uint32_t));
+  }
+
+  const std::vector<uint8_t> arena_;
+  const size_t keysOffset_;
+  const size_t stringsOffset_;
+  const bool isDeduplicated_;
+  const size_t hash_;
+  mutable PropNameIDCache propNameIDCache_;
+  mutable RuntimeValueCache valueCache_;
+};
+
+} // namespace reanimated
@@ -0,0 +1,58 @@
+#include "PropNameIDCache.h"
+
+#include <algorithm>
+
+namespace reanimated {
+
+std::mutex PropNameIDCache::cachesMutex_{};
+// Intentionally leaked, as shareables may be released after static
+// destructors have run.
+std::unordered_set<PropNameIDCache *> *const PropNameIDCache::caches_ =
+    new std::unordered_set<PropNameIDCache *>();
+
+PropNameIDCache::~PropNameIDCache() {
+  if (isRegistered_.load(std::memory_order_acquire)) {
+    std::lock_guard<std::mutex> lock(cachesMutex_);
+    caches_->erase(this);
+  }
+  for (auto &entry : entries_) {
+    if (WorkletRuntimeRegistry::getRuntimeGeneration(entry->runtime) !=
+        entry->generation) {
+      // See the comment in `cleanupIfRuntimeExists` for why we leak the
+      // property names of runtimes that are already gone.
+      entry->propNames.release();
+    }
+  }
+}
+
+void PropNameIDCache::registerCache() {
+  std::lock_guard<std::mutex> lock(cachesMutex_);
+  if (!isRegistered_.load(std::memory_order_relaxed)) {
+    caches_->insert(this);
+    isRegistered_.store(true, std::memory_order_release);
+  }
+}
+
+void PropNameIDCache::forget(jsi::Runtime &rt) {
+  std::lock_guard<std::mutex> cachesLock(cachesMutex_);
+  for (auto cache : *caches_) {
+    std::lock_guard<std::mutex> lock(cache->mutex_);
+    auto &entries = cache->entries_;
+    entries.erase(
+        std::remove_if(
+            entries.begin(),
+            entries.end(),
+            [&rt](const std::unique_ptr<Entry> &entry) {
+              if (entry->runtime != &rt) {
+                return false;
+              }
+              // See the comment in `cleanupIfRuntimeExists` for why we leak
+              // the property names of runtimes that are being torn down.
+              entry->propNames.release();
+              return true;
+            }),
+        entries.end());
+  }
+}
+
+} // namespace reanimated
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <jsi/jsi.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "WorkletRuntimeRegistry.h"
+
+using namespace facebook;
+
+namespace reanimated {
+
+// Keeps interned `jsi::PropNameID`s for a fixed list of keys, separately for
+// every worklet runtime the keys are materialized on. This lets shareables
+// skip converting C strings into property names every time they are unpacked.
+//
+// Entries are tied to the registration of a runtime in WorkletRuntimeRegistry.
+// Runtimes that are not registered there (e.g. the RN runtime) are not cached
+// at all. When a runtime is unregistered, its entries are dropped from all the
+// caches and their property names are leaked, see `cleanupIfRuntimeExists`.
+class PropNameIDCache {
+ public:
+  PropNameIDCache() = default;
+  PropNameIDCache(const PropNameIDCache &) = delete;
+  PropNameIDCache &operator=(const PropNameIDCache &) = delete;
+
+  ~PropNameIDCache();
+
+  // Returns property names for `rt`, calling `makePropNameID(i)` for each of
+  // the `size` keys on first use. Returns nullptr if `rt` is not a worklet
+  // runtime. The returned vector must only be used on the thread of `rt`.
+  template <typename MakePropNameID>
+  const std::vector<jsi::PropNameID> *
+  get(jsi::Runtime &rt, size_t size, MakePropNameID &&makePropNameID) {
+    auto generation = WorkletRuntimeRegistry::getRuntimeGeneration(&rt);
+    if (generation == 0) {
+      return nullptr;
+    }
+    if (!isRegistered_.load(std::memory_order_acquire)) {
+      registerCache();
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &entry : entries_) {
+      if (entry->runtime != &rt) {
+        continue;
+      }
+      if (entry->generation == generation) {
+        return entry->propNames.get();
+      }
+      // the runtime this entry was created for is gone and a new runtime was
+      // allocated at the same address
+      entry->propNames.release();
+      entry->generation = generation;
+      entry->propNames = makePropNames(size, makePropNameID);
+      return entry->propNames.get();
+    }
+    entries_.push_back(std::make_unique<Entry>(
+        Entry{&rt, generation, makePropNames(size, makePropNameID)}));
+    return entries_.back()->propNames.get();
+  }
+
+ private:
+  struct Entry {
+    jsi::Runtime *runtime;
+    uint64_t generation;
+    std::unique_ptr<std::vector<jsi::PropNameID>> propNames;
+  };
+
+  // Caches are registered once they are first used on a worklet runtime, so
+  // that `forget` can find them.
+  void registerCache();
+
+  // Drops the entries of `rt` from all the caches. Called when `rt` is being
+  // torn down, before it's unregistered.
+  static void forget(jsi::Runtime &rt);
+
+  template <typename MakePropNameID>
+  static std::unique_ptr<std::vector<jsi::PropNameID>> makePropNames(
+      size_t size,
+      MakePropNameID &makePropNameID) {
+    auto propNames = std::make_unique<std::vector<jsi::PropNameID>>();
+    propNames->reserve(size);
+    for (size_t i = 0; i < size; i++) {
+      propNames->push_back(makePropNameID(i));
+    }
+    return propNames;
+  }
+
+  std::mutex mutex_; // Protects `entries_`.
+  std::vector<std::unique_ptr<Entry>> entries_;
+  std::atomic_bool isRegistered_{false};
+
+  // Taken before the mutex of any cache.
+  static std::mutex cachesMutex_; // Protects `caches_`.
+  static std::unordered_set<PropNameIDCache *> *const caches_;
+
+  friend class WorkletRuntimeCollector;
+};
+
+} // namespace reanimated
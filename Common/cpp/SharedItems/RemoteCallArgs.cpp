@@ -0,0 +1,58 @@
+#include "RemoteCallArgs.h"
+
+#include <stdexcept>
+#include <utility>
+
+namespace reanimated {
+
+RemoteCallArgs::RemoteCallArgs(jsi::Runtime &rt, const jsi::Value &args) {
+  if (args.isUndefined()) {
+    return;
+  }
+  if (!args.isObject() || !args.asObject(rt).isArray(rt)) {
+    throw std::runtime_error("[Reanimated] Args must be an array.");
+  }
+  auto array = args.asObject(rt).asArray(rt);
+  auto size = array.size(rt);
+  args_.reserve(size);
+  for (size_t i = 0; i < size; i++) {
+    auto arg = array.getValueAtIndex(rt, i);
+    if (arg.isUndefined()) {
+      args_.emplace_back(std::monostate());
+    } else if (arg.isNull()) {
+      args_.emplace_back(nullptr);
+    } else if (arg.isBool()) {
+      args_.emplace_back(arg.getBool());
+    } else if (arg.isNumber()) {
+      args_.emplace_back(arg.getNumber());
+    } else if (arg.isString()) {
+      args_.emplace_back(arg.getString(rt).utf8(rt));
+    } else {
+      args_.emplace_back(extractShareableOrThrow(
+          rt,
+          arg,
+          "[Reanimated] Remote call arguments must be primitives or shareables."));
+    }
+  }
+}
+
+void RemoteCallArgs::materialize(jsi::Runtime &rt, jsi::Value *values) const {
+  for (size_t i = 0; i < args_.size(); i++) {
+    const auto &arg = args_[i];
+    if (std::holds_alternative<std::monostate>(arg)) {
+      values[i] = jsi::Value::undefined();
+    } else if (std::holds_alternative<std::nullptr_t>(arg)) {
+      values[i] = jsi::Value::null();
+    } else if (auto boolean = std::get_if<bool>(&arg)) {
+      values[i] = jsi::Value(*boolean);
+    } else if (auto number = std::get_if<double>(&arg)) {
+      values[i] = jsi::Value(*number);
+    } else if (auto string = std::get_if<std::string>(&arg)) {
+      values[i] = jsi::String::createFromUtf8(rt, *string);
+    } else {
+      values[i] = std::get<std::shared_ptr<Shareable>>(arg)->getJSValue(rt);
+    }
+  }
+}
+
+} // namespace reanimated
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <jsi/jsi.h>
+
+#include <memory>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "Shareables.h"
+
+using namespace facebook;
+
+namespace reanimated {
+
+// Arguments of a call scheduled from one runtime to a function living on
+// another one, e.g. with `runOnJS`. Primitive arguments are stored as plain
+// C++ values and anything else as a shareable. Unlike a ShareableArray, the
+// arguments are materialized straight into the argument list of the call
+// without creating a JS array first.
+class RemoteCallArgs {
+ public:
+  // `args` is either undefined or an array whose elements are primitives or
+  // shareable refs.
+  RemoteCallArgs(jsi::Runtime &rt, const jsi::Value &args);
+
+  inline size_t size() const {
+    return args_.size();
+  }
+
+  // Writes `size()` values to `values`.
+  void materialize(jsi::Runtime &rt, jsi::Value *values) const;
+
+ private:
+  using Arg = std::variant<
+      std::monostate, // undefined
+      std::nullptr_t,
+      bool,
+      double,
+      std::string,
+      std::shared_ptr<Shareable>>;
+
+  std::vector<Arg> args_;
+};
+
+} // namespace reanimated
@@ -0,0 +1,58 @@
+#include "RuntimeValueCache.h"
+
+#include <algorithm>
+
+namespace reanimated {
+
+std::mutex RuntimeValueCache::cachesMutex_{};
+// Intentionally leaked, as shareables may be released after static
+// destructors have run.
+std::unordered_set<RuntimeValueCache *> *const RuntimeValueCache::caches_ =
+    new std::unordered_set<RuntimeValueCache *>();
+
+RuntimeValueCache::~RuntimeValueCache() {
+  if (isRegistered_.load(std::memory_order_acquire)) {
+    std::lock_guard<std::mutex> lock(cachesMutex_);
+    caches_->erase(this);
+  }
+  for (auto &entry : entries_) {
+    if (WorkletRuntimeRegistry::getRuntimeGeneration(entry.runtime) !=
+        entry.generation) {
+      // See the comment in `cleanupIfRuntimeExists` for why we leak the values
+      // of runtimes that are already gone.
+      entry.value.release();
+    }
+  }
+}
+
+void RuntimeValueCache::registerCache() {
+  std::lock_guard<std::mutex> lock(cachesMutex_);
+  if (!isRegistered_.load(std::memory_order_relaxed)) {
+    caches_->insert(this);
+    isRegistered_.store(true, std::memory_order_release);
+  }
+}
+
+void RuntimeValueCache::forget(jsi::Runtime &rt) {
+  std::lock_guard<std::mutex> cachesLock(cachesMutex_);
+  for (auto cache : *caches_) {
+    std::lock_guard<std::mutex> lock(cache->mutex_);
+    auto &entries = cache->entries_;
+    entries.erase(
+        std::remove_if(
+            entries.begin(),
+            entries.end(),
+            [&rt](Entry &entry) {
+              if (entry.runtime != &rt) {
+                return false;
+              }
+              // See the comment in `cleanupIfRuntimeExists` for why we leak
+              // the values of runtimes that are being torn down.
+              entry.value.release();
+              return true;
+            }),
+        entries.end());
+  }
+}
+
+} // namespace reanimated
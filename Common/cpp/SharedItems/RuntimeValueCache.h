@@ -0,0 +1,101 @@
+#pragma once
+
+#include <jsi/jsi.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+#include "WorkletRuntimeRegistry.h"
+
+using namespace facebook;
+
+namespace reanimated {
+
+// Keeps a single JS value per runtime, e.g. the result of unpacking a
+// shareable, so that it doesn't have to be recreated every time the shareable
+// is unpacked on the same runtime.
+//
+// Similarly to PropNameIDCache, entries are tied to the registration of a
+// runtime in WorkletRuntimeRegistry. Runtimes that are not registered there
+// are not cached at all. When a runtime is unregistered, its entries are
+// dropped from all the caches and their values are leaked, see
+// `cleanupIfRuntimeExists`.
+class RuntimeValueCache {
+ public:
+  RuntimeValueCache() = default;
+  RuntimeValueCache(const RuntimeValueCache &) = delete;
+  RuntimeValueCache &operator=(const RuntimeValueCache &) = delete;
+
+  ~RuntimeValueCache();
+
+  // Returns the value cached for `rt` or caches the result of `makeValue()`.
+  template <typename MakeValue>
+  jsi::Value get(jsi::Runtime &rt, MakeValue &&makeValue) {
+    auto generation = WorkletRuntimeRegistry::getRuntimeGeneration(&rt);
+    if (generation == 0) {
+      return makeValue();
+    }
+    if (!isRegistered_.load(std::memory_order_acquire)) {
+      registerCache();
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (const auto &entry : entries_) {
+        if (entry.runtime == &rt && entry.generation == generation) {
+          return jsi::Value(rt, *entry.value);
+        }
+      }
+    }
+    // The lock is not held while making the value as it may call into JS which
+    // may in turn ask for the same value (e.g. when a worklet is captured by
+    // its own closure).
+    auto value = makeValue();
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &entry : entries_) {
+      if (entry.runtime == &rt) {
+        if (entry.generation != generation) {
+          // the runtime this value was cached for is gone and a new runtime
+          // was allocated at the same address
+          entry.value.release();
+          entry.generation = generation;
+        }
+        entry.value = std::make_unique<jsi::Value>(rt, value);
+        return value;
+      }
+    }
+    entries_.push_back(
+        {&rt, generation, std::make_unique<jsi::Value>(rt, value)});
+    return value;
+  }
+
+ private:
+  struct Entry {
+    jsi::Runtime *runtime;
+    uint64_t generation;
+    std::unique_ptr<jsi::Value> value;
+  };
+
+  // Caches are registered once they are first used on a worklet runtime, so
+  // that `forget` can find them.
+  void registerCache();
+
+  // Drops the entries of `rt` from all the caches. Called when `rt` is being
+  // torn down, before it's unregistered.
+  static void forget(jsi::Runtime &rt);
+
+  std::mutex mutex_; // Protects `entries_`.
+  std::vector<Entry> entries_;
+  std::atomic_bool isRegistered_{false};
+
+  // Taken before the mutex of any cache.
+  static std::mutex cachesMutex_; // Protects `caches_`.
+  static std::unordered_set<RuntimeValueCache *> *const caches_;
+
+  friend class WorkletRuntimeCollector;
+};
+
+} // namespace reanimated
@@ -0,0 +1,192 @@
+#include "ShareableAllocator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <new>
+
+namespace reanimated {
+
+// Slots are aligned to the granularity, which is enough for every type we
+// allocate here.
+static constexpr size_t granularity = alignof(std::max_align_t);
+static constexpr size_t maxPooledSize = 512;
+static constexpr size_t sizeClassCount = maxPooledSize / granularity;
+static constexpr size_t slotsPerSlab = 64;
+// Number of free slots a thread keeps per size class before it gives half of
+// them back to the global free list.
+static constexpr size_t maxCachedSlots = 64;
+
+struct FreeSlot {
+  FreeSlot *next;
+};
+
+struct SizeClass {
+  std::mutex mutex; // Protects `freeSlots`.
+  FreeSlot *freeSlots = nullptr;
+};
+
+// Intentionally leaked, as nodes may be released by threads that exit after
+// static destructors have already run.
+static SizeClass *const sizeClasses = new SizeClass[sizeClassCount];
+
+static std::atomic<size_t> liveNodes{0};
+static std::atomic<size_t> liveBytes{0};
+static std::atomic<size_t> highWaterBytes{0};
+static std::atomic<size_t> pooledBytes{0};
+
+static inline size_t getSizeClassIndex(size_t size) {
+  return (size - 1) / granularity;
+}
+
+static inline size_t getSlotSize(size_t sizeClassIndex) {
+  return (sizeClassIndex + 1) * granularity;
+}
+
+static void pushGlobal(size_t index, FreeSlot *first, FreeSlot *last) {
+  auto &sizeClass = sizeClasses[index];
+  std::lock_guard<std::mutex> lock(sizeClass.mutex);
+  last->next = sizeClass.freeSlots;
+  sizeClass.freeSlots = first;
+}
+
+// Returns up to `maxCount` slots from the global free list linked together or
+// a new slab if the list is empty.
+static FreeSlot *popGlobal(size_t index, size_t maxCount, size_t &count) {
+  auto &sizeClass = sizeClasses[index];
+  {
+    std::lock_guard<std::mutex> lock(sizeClass.mutex);
+    if (sizeClass.freeSlots != nullptr) {
+      FreeSlot *first = sizeClass.freeSlots;
+      FreeSlot *last = first;
+      count = 1;
+      while (count < maxCount && last->next != nullptr) {
+        last = last->next;
+        count++;
+      }
+      sizeClass.freeSlots = last->next;
+      last->next = nullptr;
+      return first;
+    }
+  }
+  auto slotSize = getSlotSize(index);
+  auto slab = static_cast<char *>(::operator new(slotSize * slotsPerSlab));
+  pooledBytes += slotSize * slotsPerSlab;
+  for (size_t i = 0; i < slotsPerSlab; i++) {
+    reinterpret_cast<FreeSlot *>(slab + i * slotSize)->next =
+        i + 1 < slotsPerSlab
+        ? reinterpret_cast<FreeSlot *>(slab + (i + 1) * slotSize)
+        : nullptr;
+  }
+  count = slotsPerSlab;
+  return reinterpret_cast<FreeSlot *>(slab);
+}
+
+struct ThreadCache {
+  FreeSlot *freeSlots[sizeClassCount] = {};
+  size_t counts[sizeClassCount] = {};
+
+  ~ThreadCache();
+};
+
+// Set once the cache of the current thread is destroyed, after that the thread
+// uses the global free lists directly.
+static thread_local bool isThreadCacheDestroyed = false;
+static thread_local ThreadCache threadCache;
+
+ThreadCache::~ThreadCache() {
+  isThreadCacheDestroyed = true;
+  for (size_t index = 0; index < sizeClassCount; index++) {
+    FreeSlot *first = freeSlots[index];
+    if (first == nullptr) {
+      continue;
+    }
+    FreeSlot *last = first;
+    while (last->next != nullptr) {
+      last = last->next;
+    }
+    pushGlobal(index, first, last);
+  }
+}
+
+static void recordAllocation(size_t size) {
+  liveNodes++;
+  auto bytes = liveBytes += size;
+  auto highWater = highWaterBytes.load(std::memory_order_relaxed);
+  while (bytes > highWater &&
+         !highWaterBytes.compare_exchange_weak(
+             highWater, bytes, std::memory_order_relaxed)) {
+  }
+}
+
+void *ShareableAllocator::allocate(size_t size) {
+  recordAllocation(size);
+  if (size > maxPooledSize) {
+    return ::operator new(size);
+  }
+  auto index = getSizeClassIndex(size);
+  if (isThreadCacheDestroyed) {
+    size_t count;
+    FreeSlot *slots = popGlobal(index, 1, count);
+    if (slots->next != nullptr) {
+      // we got a new slab, keep the rest of it in the pool
+      FreeSlot *last = slots->next;
+      while (last->next != nullptr) {
+        last = last->next;
+      }
+      pushGlobal(index, slots->next, last);
+    }
+    return slots;
+  }
+  auto &cache = threadCache;
+  if (cache.freeSlots[index] == nullptr) {
+    cache.freeSlots[index] =
+        popGlobal(index, maxCachedSlots / 2, cache.counts[index]);
+  }
+  FreeSlot *slot = cache.freeSlots[index];
+  cache.freeSlots[index] = slot->next;
+  cache.counts[index]--;
+  return slot;
+}
+
+void ShareableAllocator::deallocate(void *pointer, size_t size) {
+  liveNodes--;
+  liveBytes -= size;
+  if (size > maxPooledSize) {
+    ::operator delete(pointer);
+    return;
+  }
+  auto index = getSizeClassIndex(size);
+  auto slot = static_cast<FreeSlot *>(pointer);
+  if (isThreadCacheDestroyed) {
+    pushGlobal(index, slot, slot);
+    return;
+  }
+  auto &cache = threadCache;
+  slot->next = cache.freeSlots[index];
+  cache.freeSlots[index] = slot;
+  if (++cache.counts[index] <= maxCachedSlots) {
+    return;
+  }
+  // give half of the cached slots back so that threads that mostly release
+  // nodes don't hold on to the memory other threads allocate from
+  FreeSlot *first = cache.freeSlots[index];
+  FreeSlot *last = first;
+  for (size_t i = 1; i < maxCachedSlots / 2; i++) {
+    last = last->next;
+  }
+  cache.freeSlots[index] = last->next;
+  cache.counts[index] -= maxCachedSlots / 2;
+  pushGlobal(index, first, last);
+}
+
+ShareableAllocatorStats ShareableAllocator::getStats() {
+  return {
+      liveNodes.load(std::memory_order_relaxed),
+      liveBytes.load(std::memory_order_relaxed),
+      highWaterBytes.load(std::memory_order_relaxed),
+      pooledBytes.load(std::memory_order_relaxed),
+  };
+}
+
+} // namespace reanimated
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace reanimated {
+
+struct ShareableAllocatorStats {
+  size_t liveNodes;
+  size_t liveBytes;
+  size_t highWaterBytes;
+  // Memory reserved for the pool, including free slots.
+  size_t pooledBytes;
+};
+
+// A pool for the small, short-lived nodes created for every shareable (the
+// Shareable objects along with their control blocks and ShareableJSRef host
+// objects). Nodes are often allocated on one thread and released on another
+// (e.g. `runOnUI` arguments are cloned on the JS thread and dropped on the UI
+// thread), so every thread keeps a small cache of free slots per size class
+// and only exchanges batches of them with the global free lists, which are
+// guarded by a separate lock per size class. Pooled memory is never returned
+// to the system.
+class ShareableAllocator {
+ public:
+  static void *allocate(size_t size);
+  static void deallocate(void *pointer, size_t size);
+
+  static ShareableAllocatorStats getStats();
+};
+
+template <typename T>
+class ShareablePoolAllocator {
+ public:
+  using value_type = T;
+
+  ShareablePoolAllocator() = default;
+
+  template <typename U>
+  ShareablePoolAllocator(const ShareablePoolAllocator<U> &) {} // NOLINT
+
+  T *allocate(size_t n) {
+    return static_cast<T *>(ShareableAllocator::allocate(n * sizeof(T)));
+  }
+
+  void deallocate(T *pointer, size_t n) {
+    ShareableAllocator::deallocate(pointer, n * sizeof(T));
+  }
+
+  template <typename U>
+  bool operator==(const ShareablePoolAllocator<U> &) const {
+    return true;
+  }
+
+  template <typename U>
+  bool operator!=(const ShareablePoolAllocator<U> &) const {
+    return false;
+  }
+};
+
+// Use instead of `std::make_shared` for shareable nodes.
+template <typename T, typename... Args>
+inline std::shared_ptr<T> allocateShareable(Args &&...args) {
+  return std::allocate_shared<T>(
+      ShareablePoolAllocator<T>(), std::forward<Args>(args)...);
+}
+
+} // namespace reanimated
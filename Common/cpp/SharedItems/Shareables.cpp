@@ -1,13 +1,25 @@
 #include "Shareables.h"
+#include "FeaturesConfig.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 using namespace facebook;
 
 namespace reanimated {
 
-jsi::Function getValueUnpacker(jsi::Runtime &rt) {
-  auto valueUnpacker = rt.global().getProperty(rt, "__valueUnpacker");
-  assert(valueUnpacker.isObject() && "valueUnpacker not found");
-  return valueUnpacker.asObject(rt).asFunction(rt);
+const jsi::Function &getValueUnpacker(jsi::Runtime &rt) {
+  auto valueUnpacker =
+      GlobalFunctionHandles::get(rt, GlobalFunction::ValueUnpacker);
+  if (valueUnpacker == nullptr) {
+    throw std::runtime_error("[Reanimated] `__valueUnpacker` not found.");
+  }
+  return *valueUnpacker;
 }
 
 #ifndef NDEBUG
@@ -19,16 +31,10 @@ static const auto callGuardLambda = [](facebook::jsi::Runtime &rt,
   return args[0].asObject(rt).asFunction(rt).call(rt, args + 1, count - 1);
 };
 
-jsi::Function getCallGuard(jsi::Runtime &rt) {
-  auto callGuard = rt.global().getProperty(rt, "__callGuardDEV");
-  if (callGuard.isObject()) {
-    // Use JS implementation if `__callGuardDEV` has already been installed.
-    // This is the desired behavior.
-    return callGuard.asObject(rt).asFunction(rt);
-  }
-
-  // Otherwise, fallback to C++ JSI implementation. This is necessary so that we
-  // can install `__callGuardDEV` itself and should happen only once. Note that
+jsi::Function makeCallGuardFallback(jsi::Runtime &rt) {
+  // C++ JSI implementation used until `__callGuardDEV` is installed, see
+  // `runOnRuntimeGuarded`. This is necessary so that we can install
+  // `__callGuardDEV` itself and should happen only once. Note that
   // the C++ implementation doesn't intercept errors and simply throws them as
   // C++ exceptions which crashes the app. We assume that installing the guard
   // doesn't throw any errors.
@@ -38,63 +44,92 @@ jsi::Function getCallGuard(jsi::Runtime &rt) {
 
 #endif // NDEBUG
 
+// Packs the whole tree in one walk, so that nested objects and arrays don't
+// get shareables of their own.
+static std::shared_ptr<Shareable> makePackedShareable(
+    jsi::Runtime &rt,
+    const jsi::Object &object) {
+  PackedShareableData::Builder builder;
+  builder.addJSValue(rt, jsi::Value(rt, object));
+  auto packedData =
+      builder.build(FeaturesConfig::isShareableDeduplicationEnabled());
+  if (object.isArray(rt)) {
+    return allocateShareable<ShareableArray>(std::move(packedData));
+  }
+  return allocateShareable<ShareableObject>(std::move(packedData));
+}
+
 jsi::Value makeShareableClone(
     jsi::Runtime &rt,
     const jsi::Value &value,
-    const jsi::Value &shouldRetainRemote) {
+    const jsi::Value &shouldRetainRemote,
+    const jsi::Value &arrayBufferTransferMode,
+    const jsi::Value &isTypedArray,
+    const jsi::Value &isPlainData) {
   std::shared_ptr<Shareable> shareable;
   if (value.isObject()) {
     auto object = value.asObject(rt);
-    if (!object.getProperty(rt, "__workletHash").isUndefined()) {
-      shareable = std::make_shared<ShareableWorklet>(rt, object);
+    if (isPlainData.isBool() && isPlainData.getBool()) {
+      shareable = makePackedShareable(rt, object);
+    } else if (!object.getProperty(rt, "__workletHash").isUndefined()) {
+      shareable = allocateShareable<ShareableWorklet>(rt, object);
     } else if (!object.getProperty(rt, "__init").isUndefined()) {
-      shareable = std::make_shared<ShareableHandle>(rt, object);
+      shareable = allocateShareable<ShareableHandle>(rt, object);
     } else if (object.isFunction(rt)) {
       auto function = object.asFunction(rt);
       if (function.isHostFunction(rt)) {
         shareable =
-            std::make_shared<ShareableHostFunction>(rt, std::move(function));
+            allocateShareable<ShareableHostFunction>(rt, std::move(function));
       } else {
         shareable =
-            std::make_shared<ShareableRemoteFunction>(rt, std::move(function));
+            allocateShareable<ShareableRemoteFunction>(rt, std::move(function));
       }
     } else if (object.isArray(rt)) {
       if (shouldRetainRemote.isBool() && shouldRetainRemote.getBool()) {
-        shareable = std::make_shared<RetainingShareable<ShareableArray>>(
-            rt, object.asArray(rt));
+        shareable = allocateShareable<RetainingShareable<ShareableArray>>(
+            rt, object.asArray(rt), false /* allowPacking */);
       } else {
-        shareable = std::make_shared<ShareableArray>(rt, object.asArray(rt));
+        shareable = allocateShareable<ShareableArray>(rt, object.asArray(rt));
       }
     } else if (object.isArrayBuffer(rt)) {
-      shareable =
-          std::make_shared<ShareableArrayBuffer>(rt, object.getArrayBuffer(rt));
+      shareable = allocateShareable<ShareableArrayBuffer>(
+          rt,
+          object.getArrayBuffer(rt),
+          ShareableArrayBuffer::parseTransferMode(
+              rt, arrayBufferTransferMode));
     } else if (object.isHostObject(rt)) {
       if (object.isHostObject<ShareableJSRef>(rt)) {
         return object;
       }
       shareable =
-          std::make_shared<ShareableHostObject>(rt, object.getHostObject(rt));
+          allocateShareable<ShareableHostObject>(rt, object.getHostObject(rt));
+    } else if (isTypedArray.isBool() && isTypedArray.getBool()) {
+      shareable = allocateShareable<ShareableTypedArray>(
+          rt,
+          object,
+          ShareableArrayBuffer::parseTransferMode(
+              rt, arrayBufferTransferMode));
     } else {
       if (shouldRetainRemote.isBool() && shouldRetainRemote.getBool()) {
-        shareable =
-            std::make_shared<RetainingShareable<ShareableObject>>(rt, object);
+        shareable = allocateShareable<RetainingShareable<ShareableObject>>(
+            rt, object, false /* allowPacking */);
       } else {
-        shareable = std::make_shared<ShareableObject>(rt, object);
+        shareable = allocateShareable<ShareableObject>(rt, object);
       }
     }
   } else if (value.isString()) {
-    shareable = std::make_shared<ShareableString>(value.asString(rt).utf8(rt));
+    shareable = allocateShareable<ShareableString>(value.asString(rt).utf8(rt));
   } else if (value.isUndefined()) {
-    shareable = std::make_shared<ShareableScalar>();
+    shareable = allocateShareable<ShareableScalar>();
   } else if (value.isNull()) {
-    shareable = std::make_shared<ShareableScalar>(nullptr);
+    shareable = allocateShareable<ShareableScalar>(nullptr);
   } else if (value.isBool()) {
-    shareable = std::make_shared<ShareableScalar>(value.getBool());
+    shareable = allocateShareable<ShareableScalar>(value.getBool());
   } else if (value.isNumber()) {
-    shareable = std::make_shared<ShareableScalar>(value.getNumber());
+    shareable = allocateShareable<ShareableScalar>(value.getNumber());
 #if REACT_NATIVE_MINOR_VERSION >= 71
   } else if (value.isBigInt()) {
-    shareable = std::make_shared<ShareableBigInt>(rt, value.getBigInt(rt));
+    shareable = allocateShareable<ShareableBigInt>(rt, value.getBigInt(rt));
 #endif
   } else if (value.isSymbol()) {
     // TODO: this is only a placeholder implementation, here we replace symbols
@@ -102,7 +137,7 @@ jsi::Value makeShareableClone(
     // yet any usecase for using symbols on the UI runtime so it is fine to keep
     // it like this for now.
     shareable =
-        std::make_shared<ShareableString>(value.getSymbol(rt).toString(rt));
+        allocateShareable<ShareableString>(value.getSymbol(rt).toString(rt));
   } else {
     throw std::runtime_error(
         "[Reanimated] Attempted to convert an unsupported value type.");
@@ -159,36 +194,212 @@ jsi::Value RetainingShareable<BaseClass>::getJSValue(jsi::Runtime &rt) {
 
 ShareableJSRef::~ShareableJSRef() {}
 
-ShareableArray::ShareableArray(jsi::Runtime &rt, const jsi::Array &array)
+// Appends `shareable` to `builder` and returns true if it only consists of
+// plain data. Otherwise returns false, in which case the builder is left in an
+// unspecified state and should be discarded.
+static bool packShareable(
+    PackedShareableData::Builder &builder,
+    const Shareable &shareable) {
+  switch (shareable.valueType()) {
+    case Shareable::UndefinedType:
+      builder.addUndefined();
+      return true;
+    case Shareable::NullType:
+      builder.addNull();
+      return true;
+    case Shareable::BooleanType:
+      builder.addBoolean(
+          static_cast<const ShareableScalar &>(shareable).getBool());
+      return true;
+    case Shareable::NumberType:
+      builder.addNumber(
+          static_cast<const ShareableScalar &>(shareable).getNumber());
+      return true;
+    case Shareable::StringType:
+      builder.addString(
+          static_cast<const ShareableString &>(shareable).value());
+      return true;
+    default:
+      return false;
+  }
+}
+
+ShareableArray::ShareableArray(
+    jsi::Runtime &rt,
+    const jsi::Array &array,
+    bool allowPacking)
     : Shareable(ArrayType) {
   auto size = array.size(rt);
   data_.reserve(size);
   for (size_t i = 0; i < size; i++) {
     data_.push_back(extractShareableOrThrow(rt, array.getValueAtIndex(rt, i)));
   }
+  if (!allowPacking) {
+    return;
+  }
+  PackedShareableData::Builder builder;
+  builder.beginArray(size);
+  for (const auto &item : data_) {
+    if (!packShareable(builder, *item)) {
+      return;
+    }
+  }
+  packedData_ =
+      builder.build(FeaturesConfig::isShareableDeduplicationEnabled());
+  // the packed arena holds a copy of all the elements so we can release the
+  // child nodes right away
+  data_ = {};
 }
 
 jsi::Value ShareableArray::toJSValue(jsi::Runtime &rt) {
+  if (packedData_ != nullptr) {
+    return packedData_->toJSValue(rt);
+  }
   auto size = data_.size();
   auto ary = jsi::Array(rt, size);
   for (size_t i = 0; i < size; i++) {
-    ary.setValueAtIndex(rt, i, data_[i]->getJSValue(rt));
+    ary.setValueAtIndex(rt, i, getChildJSValue(rt, *data_[i]));
   }
   return ary;
 }
 
+ShareableArrayBuffer::TransferMode ShareableArrayBuffer::parseTransferMode(
+    jsi::Runtime &rt,
+    const jsi::Value &transferMode) {
+  if (transferMode.isUndefined()) {
+    return TransferMode::Copy;
+  }
+  if (transferMode.isString()) {
+    auto mode = transferMode.asString(rt).utf8(rt);
+    if (mode == "copy") {
+      return TransferMode::Copy;
+    } else if (mode == "share") {
+      return TransferMode::Share;
+    } else if (mode == "transfer") {
+      return TransferMode::Transfer;
+    }
+  }
+  throw std::runtime_error(
+      "[Reanimated] ArrayBuffer transfer mode must be one of 'copy', 'share' or 'transfer'.");
+}
+
+#if REACT_NATIVE_MINOR_VERSION >= 72
+// Exposes the native memory of ShareableArrayBuffer to JSI without copying it.
+// The memory stays alive as long as any of the shareable or the array buffers
+// created from it.
+class ShareableArrayBufferStorage : public jsi::MutableBuffer {
+ public:
+  explicit ShareableArrayBufferStorage(
+      const std::shared_ptr<std::vector<uint8_t>> &data)
+      : data_(data) {}
+
+  size_t size() const override {
+    return data_->size();
+  }
+
+  uint8_t *data() override {
+    return data_->data();
+  }
+
+ private:
+  const std::shared_ptr<std::vector<uint8_t>> data_;
+};
+
+// JSC doesn't implement array buffers backed by external memory, we remember
+// that after the first failed attempt so that we don't pay for the exception
+// every time.
+static std::atomic<bool> externalArrayBuffersSupported{true};
+#endif // REACT_NATIVE_MINOR_VERSION >= 72
+
 jsi::Value ShareableArrayBuffer::toJSValue(jsi::Runtime &rt) {
-  auto size = static_cast<int>(data_.size());
+  std::shared_ptr<std::vector<uint8_t>> data;
+  if (transferMode_ == TransferMode::Transfer) {
+    std::lock_guard<std::mutex> lock(dataMutex_);
+    if (!data_) {
+      throw std::runtime_error(
+          "[Reanimated] ArrayBuffer has already been transferred to another runtime.");
+    }
+    data = std::move(data_);
+  } else {
+    data = data_;
+  }
+#if REACT_NATIVE_MINOR_VERSION >= 72
+  if (transferMode_ != TransferMode::Copy && externalArrayBuffersSupported) {
+    try {
+      return jsi::ArrayBuffer(
+          rt, std::make_shared<ShareableArrayBufferStorage>(data));
+    } catch (const std::exception &) {
+      externalArrayBuffersSupported = false;
+    }
+  }
+#endif // REACT_NATIVE_MINOR_VERSION >= 72
+  auto size = static_cast<int>(data->size());
   auto arrayBuffer = rt.global()
                          .getPropertyAsFunction(rt, "ArrayBuffer")
                          .callAsConstructor(rt, size)
                          .getObject(rt)
                          .getArrayBuffer(rt);
-  memcpy(arrayBuffer.data(rt), data_.data(), size);
+  memcpy(arrayBuffer.data(rt), data->data(), size);
   return arrayBuffer;
 }
 
-ShareableObject::ShareableObject(jsi::Runtime &rt, const jsi::Object &object)
+static constexpr const char *typedArrayConstructorNames[] = {
+    "Int8Array",
+    "Uint8Array",
+    "Uint8ClampedArray",
+    "Int16Array",
+    "Uint16Array",
+    "Int32Array",
+    "Uint32Array",
+    "Float32Array",
+    "Float64Array",
+    "BigInt64Array",
+    "BigUint64Array",
+};
+
+ShareableTypedArray::ShareableTypedArray(
+    jsi::Runtime &rt,
+    const jsi::Object &typedArray,
+    ShareableArrayBuffer::TransferMode transferMode)
+    : Shareable(TypedArrayType) {
+  auto constructorName = typedArray.getProperty(rt, "constructor")
+                             .asObject(rt)
+                             .getProperty(rt, "name")
+                             .asString(rt)
+                             .utf8(rt);
+  auto it = std::find(
+      std::begin(typedArrayConstructorNames),
+      std::end(typedArrayConstructorNames),
+      constructorName);
+  if (it == std::end(typedArrayConstructorNames)) {
+    throw std::runtime_error(
+        "[Reanimated] Invalid typed array type `" + constructorName + "`.");
+  }
+  elementType_ = static_cast<ElementType>(
+      std::distance(std::begin(typedArrayConstructorNames), it));
+  auto arrayBuffer = typedArray.getProperty(rt, "buffer")
+                         .asObject(rt)
+                         .getArrayBuffer(rt);
+  auto byteOffset =
+      static_cast<size_t>(typedArray.getProperty(rt, "byteOffset").asNumber());
+  auto byteLength =
+      static_cast<size_t>(typedArray.getProperty(rt, "byteLength").asNumber());
+  buffer_ = allocateShareable<ShareableArrayBuffer>(
+      arrayBuffer.data(rt) + byteOffset, byteLength, transferMode);
+}
+
+jsi::Value ShareableTypedArray::toJSValue(jsi::Runtime &rt) {
+  auto constructorName =
+      typedArrayConstructorNames[static_cast<size_t>(elementType_)];
+  return rt.global()
+      .getPropertyAsFunction(rt, constructorName)
+      .callAsConstructor(rt, buffer_->getJSValue(rt));
+}
+
+ShareableObject::ShareableObject(
+    jsi::Runtime &rt,
+    const jsi::Object &object,
+    bool allowPacking)
     : Shareable(ObjectType) {
   auto propertyNames = object.getPropertyNames(rt);
   auto size = propertyNames.size(rt);
@@ -198,13 +409,41 @@ ShareableObject::ShareableObject(jsi::Runtime &rt, const jsi::Object &object)
     auto value = extractShareableOrThrow(rt, object.getProperty(rt, key));
     data_.emplace_back(key.utf8(rt), value);
   }
+  if (!allowPacking) {
+    return;
+  }
+  PackedShareableData::Builder builder;
+  builder.beginObject(size);
+  for (const auto &[key, value] : data_) {
+    builder.addKey(key);
+    if (!packShareable(builder, *value)) {
+      return;
+    }
+  }
+  packedData_ =
+      builder.build(FeaturesConfig::isShareableDeduplicationEnabled());
+  data_ = {};
 }
 
 jsi::Value ShareableObject::toJSValue(jsi::Runtime &rt) {
+  if (packedData_ != nullptr) {
+    return packedData_->toJSValue(rt);
+  }
   auto obj = jsi::Object(rt);
-  for (size_t i = 0, size = data_.size(); i < size; i++) {
+  auto size = data_.size();
+  auto propNames = propNameIDCache_.get(rt, size, [&](size_t i) {
+    return jsi::PropNameID::forUtf8(rt, data_[i].first);
+  });
+  if (propNames != nullptr) {
+    for (size_t i = 0; i < size; i++) {
+      obj.setProperty(
+          rt, (*propNames)[i], getChildJSValue(rt, *data_[i].second));
+    }
+    return obj;
+  }
+  for (size_t i = 0; i < size; i++) {
     obj.setProperty(
-        rt, data_[i].first.c_str(), data_[i].second->getJSValue(rt));
+        rt, data_[i].first.c_str(), getChildJSValue(rt, *data_[i].second));
   }
   return obj;
 }
@@ -225,8 +464,10 @@ jsi::Value ShareableWorklet::toJSValue(jsi::Runtime &rt) {
           data_.cend(),
           [](const auto &item) { return item.first == "__workletHash"; }) &&
       "ShareableWorklet doesn't have `__workletHash` property");
-  jsi::Value obj = ShareableObject::toJSValue(rt);
-  return getValueUnpacker(rt).call(rt, obj);
+  return cachedFunctions_.get(rt, [&]() {
+    jsi::Value obj = ShareableObject::toJSValue(rt);
+    return getValueUnpacker(rt).call(rt, obj);
+  });
 }
 
 jsi::Value ShareableRemoteFunction::toJSValue(jsi::Runtime &rt) {
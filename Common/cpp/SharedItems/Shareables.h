@@ -2,20 +2,26 @@
 
 #include <jsi/jsi.h>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "GlobalFunctionHandles.h"
+#include "PackedShareableData.h"
+#include "PropNameIDCache.h"
+#include "RuntimeValueCache.h"
+#include "ShareableAllocator.h"
 #include "WorkletRuntimeRegistry.h"
 
 using namespace facebook;
 
 namespace reanimated {
 
-jsi::Function getValueUnpacker(jsi::Runtime &rt);
+const jsi::Function &getValueUnpacker(jsi::Runtime &rt);
 
 #ifndef NDEBUG
-jsi::Function getCallGuard(jsi::Runtime &rt);
+jsi::Function makeCallGuardFallback(jsi::Runtime &rt);
 #endif // NDEBUG
 
 // If possible, please use `WorkletRuntime::runGuarded` instead.
@@ -29,7 +35,13 @@ inline jsi::Value runOnRuntimeGuarded(
   // JavaScript and propagating them to the main React Native thread such that
   // they can be presented using RN's LogBox.
 #ifndef NDEBUG
-  return getCallGuard(rt).call(rt, function, args...);
+  auto callGuard = GlobalFunctionHandles::get(rt, GlobalFunction::CallGuard);
+  if (callGuard != nullptr) {
+    // Use JS implementation if `__callGuardDEV` has already been installed.
+    // This is the desired behavior.
+    return callGuard->call(rt, function, args...);
+  }
+  return makeCallGuardFallback(rt).call(rt, function, args...);
 #else
   return function.asObject(rt).asFunction(rt).call(rt, args...);
 #endif
@@ -84,6 +96,7 @@ class Shareable {
     HostObjectType,
     HostFunctionType,
     ArrayBufferType,
+    TypedArrayType,
   };
 
   explicit Shareable(ValueType valueType) : valueType_(valueType) {}
@@ -139,14 +152,22 @@ class ShareableJSRef : public jsi::HostObject {
       jsi::Runtime &rt,
       const std::shared_ptr<Shareable> &value) {
     return jsi::Object::createFromHostObject(
-        rt, std::make_shared<ShareableJSRef>(value));
+        rt, allocateShareable<ShareableJSRef>(value));
   }
 };
 
+// JSI can't tell typed arrays apart from other objects, hence `isTypedArray`
+// has to be checked with `ArrayBuffer.isView` by the caller. `isPlainData`
+// tells that the value is a tree of plain objects, arrays and primitives only,
+// so that it can be packed in a single walk without making a shareable for
+// every nested object.
 jsi::Value makeShareableClone(
     jsi::Runtime &rt,
     const jsi::Value &value,
-    const jsi::Value &shouldRetainRemote);
+    const jsi::Value &shouldRetainRemote,
+    const jsi::Value &arrayBufferTransferMode = jsi::Value::undefined(),
+    const jsi::Value &isTypedArray = jsi::Value::undefined(),
+    const jsi::Value &isPlainData = jsi::Value::undefined());
 
 std::shared_ptr<Shareable> extractShareableOrThrow(
     jsi::Runtime &rt,
@@ -154,38 +175,68 @@ std::shared_ptr<Shareable> extractShareableOrThrow(
     const std::string &errorMessage =
         "[Reanimated] Expecting the object to be of type ShareableJSRef.");
 
+// Every shareable class defines `hasValueType` which tells whether a shareable
+// of the given value type is an instance of that class. We use it instead of
+// `dynamic_pointer_cast` as this is called for every shareable passed from JS.
 template <typename T>
 std::shared_ptr<T> extractShareableOrThrow(
     jsi::Runtime &rt,
     const jsi::Value &shareableRef,
     const std::string &errorMessage =
         "[Reanimated] Provided shareable object is of an incompatible type.") {
-  auto res = std::dynamic_pointer_cast<T>(
-      extractShareableOrThrow(rt, shareableRef, errorMessage));
-  if (!res) {
+  auto shareable = extractShareableOrThrow(rt, shareableRef, errorMessage);
+  if (!T::hasValueType(shareable->valueType())) {
     throw std::runtime_error(errorMessage);
   }
-  return res;
+  return std::static_pointer_cast<T>(shareable);
 }
 
+// When `allowPacking` is set and all the elements (or properties) are
+// primitives, ShareableArray and ShareableObject drop their child nodes and
+// keep them in a PackedShareableData arena instead. Whole plain-data trees are
+// packed up front and passed to the constructors taking PackedShareableData.
+// Retained shareables must never be packed as packed data materializes a
+// fresh copy and hence loses the identity of the retained value.
 class ShareableArray : public Shareable {
  public:
-  ShareableArray(jsi::Runtime &rt, const jsi::Array &array);
+  ShareableArray(
+      jsi::Runtime &rt,
+      const jsi::Array &array,
+      bool allowPacking = true);
+  explicit ShareableArray(std::shared_ptr<const PackedShareableData> packedData)
+      : Shareable(ArrayType), packedData_(std::move(packedData)) {}
 
   jsi::Value toJSValue(jsi::Runtime &rt) override;
 
+  static inline bool hasValueType(ValueType valueType) {
+    return valueType == ArrayType;
+  }
+
  protected:
   std::vector<std::shared_ptr<Shareable>> data_;
+  std::shared_ptr<const PackedShareableData> packedData_;
 };
 
 class ShareableObject : public Shareable {
  public:
-  ShareableObject(jsi::Runtime &rt, const jsi::Object &object);
+  ShareableObject(
+      jsi::Runtime &rt,
+      const jsi::Object &object,
+      bool allowPacking = true);
+  explicit ShareableObject(
+      std::shared_ptr<const PackedShareableData> packedData)
+      : Shareable(ObjectType), packedData_(std::move(packedData)) {}
 
   jsi::Value toJSValue(jsi::Runtime &rt) override;
 
+  static inline bool hasValueType(ValueType valueType) {
+    return valueType == ObjectType || valueType == WorkletType;
+  }
+
  protected:
   std::vector<std::pair<std::string, std::shared_ptr<Shareable>>> data_;
+  std::shared_ptr<const PackedShareableData> packedData_;
+  PropNameIDCache propNameIDCache_;
 };
 
 class ShareableHostObject : public Shareable {
@@ -197,6 +248,10 @@ class ShareableHostObject : public Shareable {
 
   jsi::Value toJSValue(jsi::Runtime &rt) override;
 
+  static inline bool hasValueType(ValueType valueType) {
+    return valueType == HostObjectType;
+  }
+
  protected:
   const std::shared_ptr<jsi::HostObject> hostObject_;
 };
@@ -213,6 +268,10 @@ class ShareableHostFunction : public Shareable {
 
   jsi::Value toJSValue(jsi::Runtime &rt) override;
 
+  static inline bool hasValueType(ValueType valueType) {
+    return valueType == HostFunctionType;
+  }
+
  protected:
   const jsi::HostFunctionType hostFunction_;
   const std::string name_;
@@ -221,34 +280,124 @@ class ShareableHostFunction : public Shareable {
 
 class ShareableArrayBuffer : public Shareable {
  public:
+  // Decides how the contents of the buffer are handed over to the runtimes the
+  // shareable is unpacked on.
+  //   Copy:     every runtime receives its own copy of the data.
+  //   Share:    every runtime receives a buffer backed by the same native
+  //             memory. The buffer must be treated as read-only afterwards, as
+  //             writes from different threads would race with each other.
+  //   Transfer: the first runtime that unpacks the shareable takes over the
+  //             native memory, any later attempt to unpack it throws.
+  // Share and Transfer avoid copying the data only on engines that support
+  // array buffers backed by external memory, otherwise they fall back to
+  // copying it.
+  enum class TransferMode {
+    Copy,
+    Share,
+    Transfer,
+  };
+
   ShareableArrayBuffer(
       jsi::Runtime &rt,
 #if REACT_NATIVE_MINOR_VERSION >= 72
-      const jsi::ArrayBuffer &arrayBuffer
+      const jsi::ArrayBuffer &arrayBuffer,
 #else
-      jsi::ArrayBuffer arrayBuffer
+      jsi::ArrayBuffer arrayBuffer,
 #endif
-      )
-      : Shareable(ArrayBufferType),
-        data_(
+      TransferMode transferMode = TransferMode::Copy)
+      : ShareableArrayBuffer(
             arrayBuffer.data(rt),
-            arrayBuffer.data(rt) + arrayBuffer.size(rt)) {
+            arrayBuffer.size(rt),
+            transferMode) {}
+
+  ShareableArrayBuffer(
+      const uint8_t *data,
+      size_t size,
+      TransferMode transferMode = TransferMode::Copy)
+      : Shareable(ArrayBufferType),
+        transferMode_(transferMode),
+        data_(std::make_shared<std::vector<uint8_t>>(data, data + size)) {}
+
+  jsi::Value toJSValue(jsi::Runtime &rt) override;
+
+  static inline bool hasValueType(ValueType valueType) {
+    return valueType == ArrayBufferType;
   }
 
+  static TransferMode parseTransferMode(
+      jsi::Runtime &rt,
+      const jsi::Value &transferMode);
+
+ protected:
+  const TransferMode transferMode_;
+  std::mutex dataMutex_; // Protects `data_` in the Transfer mode.
+  std::shared_ptr<std::vector<uint8_t>> data_;
+};
+
+// Keeps the elements of a typed array (e.g. Float32Array) in contiguous native
+// memory along with their type, so that the array can be recreated on another
+// runtime with a single copy of its buffer (or without copying, depending on
+// the transfer mode) instead of converting each element separately. Only the
+// part of the underlying buffer that is visible through the view is captured.
+class ShareableTypedArray : public Shareable {
+ public:
+  enum class ElementType : uint8_t {
+    Int8,
+    Uint8,
+    Uint8Clamped,
+    Int16,
+    Uint16,
+    Int32,
+    Uint32,
+    Float32,
+    Float64,
+    BigInt64,
+    BigUint64,
+  };
+
+  ShareableTypedArray(
+      jsi::Runtime &rt,
+      const jsi::Object &typedArray,
+      ShareableArrayBuffer::TransferMode transferMode =
+          ShareableArrayBuffer::TransferMode::Copy);
+
   jsi::Value toJSValue(jsi::Runtime &rt) override;
 
+  static inline bool hasValueType(ValueType valueType) {
+    return valueType == TypedArrayType;
+  }
+
+  inline ElementType elementType() const {
+    return elementType_;
+  }
+
  protected:
-  const std::vector<uint8_t> data_;
+  ElementType elementType_;
+  std::shared_ptr<ShareableArrayBuffer> buffer_;
 };
 
+// ShareableWorklet keeps the function returned by the value unpacker for every
+// worklet runtime it has been unpacked on, so that scheduling the same worklet
+// repeatedly doesn't rebuild its closure and bind a new function each time.
+// Similarly to RetainingShareable, the cached functions are tied to the
+// registration of their runtime in WorkletRuntimeRegistry (which is driven by
+// WorkletRuntimeCollector) and are leaked once the runtime is gone, see
+// RuntimeValueCache.
 class ShareableWorklet : public ShareableObject {
  public:
   ShareableWorklet(jsi::Runtime &rt, const jsi::Object &worklet)
-      : ShareableObject(rt, worklet) {
+      : ShareableObject(rt, worklet, false /* allowPacking */) {
     valueType_ = WorkletType;
   }
 
   jsi::Value toJSValue(jsi::Runtime &rt) override;
+
+  static inline bool hasValueType(ValueType valueType) {
+    return valueType == WorkletType;
+  }
+
+ private:
+  RuntimeValueCache cachedFunctions_;
 };
 
 class ShareableRemoteFunction
@@ -269,6 +418,10 @@ class ShareableRemoteFunction
   }
 
   jsi::Value toJSValue(jsi::Runtime &rt) override;
+
+  static inline bool hasValueType(ValueType valueType) {
+    return valueType == RemoteFunctionType;
+  }
 };
 
 class ShareableHandle : public Shareable {
@@ -288,6 +441,10 @@ class ShareableHandle : public Shareable {
   }
 
   jsi::Value toJSValue(jsi::Runtime &rt) override;
+
+  static inline bool hasValueType(ValueType valueType) {
+    return valueType == HandleType;
+  }
 };
 
 class ShareableString : public Shareable {
@@ -297,6 +454,14 @@ class ShareableString : public Shareable {
 
   jsi::Value toJSValue(jsi::Runtime &rt) override;
 
+  static inline bool hasValueType(ValueType valueType) {
+    return valueType == StringType;
+  }
+
+  inline const std::string &value() const {
+    return data_;
+  }
+
  protected:
   const std::string data_;
 };
@@ -309,6 +474,10 @@ class ShareableBigInt : public Shareable {
 
   jsi::Value toJSValue(jsi::Runtime &rt) override;
 
+  static inline bool hasValueType(ValueType valueType) {
+    return valueType == BigIntType;
+  }
+
  protected:
   const std::string string_;
 };
@@ -327,6 +496,21 @@ class ShareableScalar : public Shareable {
 
   jsi::Value toJSValue(jsi::Runtime &);
 
+  static inline bool hasValueType(ValueType valueType) {
+    return valueType == UndefinedType || valueType == NullType ||
+        valueType == BooleanType || valueType == NumberType;
+  }
+
+  inline bool getBool() const {
+    assert(valueType_ == BooleanType);
+    return data_.boolean;
+  }
+
+  inline double getNumber() const {
+    assert(valueType_ == NumberType);
+    return data_.number;
+  }
+
  protected:
   union Data {
     bool boolean;
@@ -337,4 +521,26 @@ class ShareableScalar : public Shareable {
   Data data_;
 };
 
+// Scalars and strings make up most of the children of arrays and objects, so
+// they are materialized by switching on the value type rather than through the
+// virtual `getJSValue`. Leaves are never wrapped in RetainingShareable, so this
+// gives the same result as the virtual call.
+inline jsi::Value getChildJSValue(jsi::Runtime &rt, Shareable &shareable) {
+  switch (shareable.valueType()) {
+    case Shareable::UndefinedType:
+      return jsi::Value::undefined();
+    case Shareable::NullType:
+      return jsi::Value::null();
+    case Shareable::BooleanType:
+      return jsi::Value(static_cast<ShareableScalar &>(shareable).getBool());
+    case Shareable::NumberType:
+      return jsi::Value(static_cast<ShareableScalar &>(shareable).getNumber());
+    case Shareable::StringType:
+      return jsi::String::createFromUtf8(
+          rt, static_cast<ShareableString &>(shareable).value());
+    default:
+      return shareable.getJSValue(rt);
+  }
+}
+
 } // namespace reanimated
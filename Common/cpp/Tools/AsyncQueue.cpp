@@ -1,29 +1,105 @@
 #include "AsyncQueue.h"
 
+#include <algorithm>
 #include <utility>
 
 namespace reanimated {
 
-AsyncQueue::AsyncQueue(std::string name)
-    : state_(std::make_shared<AsyncQueueState>()) {
+static constexpr size_t kInitialUnboundedCapacity = 16;
+
+AsyncQueueState::AsyncQueueState(const AsyncQueueConfig &config)
+    : config(config) {
+  slots.resize(
+      config.capacity != 0 ? config.capacity : kInitialUnboundedCapacity);
+  stats.capacity = config.capacity;
+}
+
+void AsyncQueueState::pushBack(Slot &&slot) {
+  if (size == slots.size()) {
+    grow();
+  }
+  auto sequence = headSequence + size;
+  if (slot.mergeKey != 0) {
+    mergeKeySequences[slot.mergeKey] = sequence;
+  }
+  slots[(head + size) % slots.size()] = std::move(slot);
+  size++;
+  stats.maxDepth = std::max(stats.maxDepth, size);
+}
+
+AsyncQueueState::Slot AsyncQueueState::popFront() {
+  auto slot = std::move(slots[head]);
+  if (slot.mergeKey != 0) {
+    auto it = mergeKeySequences.find(slot.mergeKey);
+    if (it != mergeKeySequences.end() && it->second == headSequence) {
+      mergeKeySequences.erase(it);
+    }
+  }
+  head = (head + 1) % slots.size();
+  size--;
+  headSequence++;
+  return slot;
+}
+
+void AsyncQueueState::grow() {
+  std::vector<Slot> grown(slots.size() * 2);
+  for (size_t i = 0; i < size; i++) {
+    grown[i] = std::move(slots[(head + i) % slots.size()]);
+  }
+  slots = std::move(grown);
+  head = 0;
+}
+
+AsyncQueue::AsyncQueue(std::string name, const AsyncQueueConfig &config)
+    : state_(std::make_shared<AsyncQueueState>(config)) {
   auto thread = std::thread([name, state = state_] {
 #if __APPLE__
     pthread_setname_np(name.c_str());
 #endif
+    {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      state->workerThreadId = std::this_thread::get_id();
+    }
+    std::vector<AsyncQueueState::Slot> batch;
     while (state->running) {
       std::unique_lock<std::mutex> lock(state->mutex);
       state->cv.wait(
-          lock, [state] { return !state->queue.empty() || !state->running; });
+          lock, [state] { return state->size != 0 || !state->running; });
       if (!state->running) {
         return;
       }
-      if (state->queue.empty()) {
-        continue;
+      // we take all the pending jobs at once instead of waking up for each
+      while (state->size != 0) {
+        batch.push_back(state->popFront());
       }
-      auto job = std::move(state->queue.front());
-      state->queue.pop();
       lock.unlock();
-      job();
+      state->notFullCv.notify_all();
+
+      double batchLatencyMs = 0;
+      double lastLatencyMs = 0;
+      size_t processed = 0;
+      for (auto &slot : batch) {
+        if (!state->running) {
+          break;
+        }
+        lastLatencyMs = std::chrono::duration<double, std::milli>(
+                            AsyncQueueState::Clock::now() - slot.pushedAt)
+                            .count();
+        batchLatencyMs += lastLatencyMs;
+        processed++;
+        slot.job();
+      }
+      batch.clear();
+      if (processed == 0) {
+        continue;
+      }
+
+      lock.lock();
+      state->stats.processed += processed;
+      state->stats.lastLatencyMs = lastLatencyMs;
+      state->totalLatencyMs += batchLatencyMs;
+      state->stats.averageLatencyMs =
+          state->totalLatencyMs / state->stats.processed;
     }
   });
 #ifdef ANDROID
@@ -36,17 +112,74 @@ AsyncQueue::~AsyncQueue() {
   {
     std::unique_lock<std::mutex> lock(state_->mutex);
     state_->running = false;
-    state_->queue = {};
+    state_->slots = {};
+    state_->size = 0;
+    state_->mergeKeySequences = {};
   }
   state_->cv.notify_all();
+  state_->notFullCv.notify_all();
 }
 
-void AsyncQueue::push(std::function<void()> &&job) {
+bool AsyncQueue::push(std::function<void()> &&job, uint64_t mergeKey) {
+  const auto &config = state_->config;
+  AsyncQueueState::Slot slot{
+      std::move(job), mergeKey, AsyncQueueState::Clock::now()};
+  // dropped jobs are destroyed outside of the lock
+  AsyncQueueState::Slot droppedSlot;
   {
     std::unique_lock<std::mutex> lock(state_->mutex);
-    state_->queue.emplace(job);
+    if (!state_->running) {
+      return false;
+    }
+    if (config.overflowPolicy == AsyncQueueOverflowPolicy::Merge &&
+        mergeKey != 0) {
+      auto it = state_->mergeKeySequences.find(mergeKey);
+      if (it != state_->mergeKeySequences.end()) {
+        auto index = (state_->head + (it->second - state_->headSequence)) %
+            state_->slots.size();
+        // the replaced job keeps its place and the time it was pushed at
+        std::swap(state_->slots[index].job, slot.job);
+        droppedSlot = std::move(slot);
+        state_->stats.merged++;
+        return true;
+      }
+    }
+    if (config.capacity != 0 && state_->size >= config.capacity) {
+      switch (config.overflowPolicy) {
+        case AsyncQueueOverflowPolicy::Block:
+          if (std::this_thread::get_id() == state_->workerThreadId) {
+            // waiting would deadlock, `pushBack` grows the ring instead
+            break;
+          }
+          state_->notFullCv.wait(lock, [this, &config] {
+            return state_->size < config.capacity || !state_->running;
+          });
+          if (!state_->running) {
+            return false;
+          }
+          break;
+        case AsyncQueueOverflowPolicy::DropOldest:
+        case AsyncQueueOverflowPolicy::Merge:
+          droppedSlot = state_->popFront();
+          state_->stats.dropped++;
+          break;
+        case AsyncQueueOverflowPolicy::DropNewest:
+          droppedSlot = std::move(slot);
+          state_->stats.dropped++;
+          return false;
+      }
+    }
+    state_->pushBack(std::move(slot));
   }
   state_->cv.notify_one();
+  return true;
+}
+
+AsyncQueueStats AsyncQueue::getStats() const {
+  std::lock_guard<std::mutex> lock(state_->mutex);
+  auto stats = state_->stats;
+  stats.depth = state_->size;
+  return stats;
 }
 
 } // namespace reanimated
@@ -3,30 +3,97 @@
 #include <jsi/jsi.h>
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <cstdint>
+#include <functional>
 #include <memory>
-#include <queue>
+#include <mutex>
 #include <string>
 #include <thread>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 namespace reanimated {
 
+// Decides what happens to a job pushed to an AsyncQueue that is already full.
+enum class AsyncQueueOverflowPolicy {
+  // `push` waits until the worker makes space in the queue. Jobs pushed from
+  // the worker thread itself can't wait for it, so they are accepted and the
+  // queue grows past its capacity until the worker catches up.
+  Block,
+  // The oldest pending job is dropped.
+  DropOldest,
+  // The pushed job is dropped.
+  DropNewest,
+  // A pending job with the same merge key is replaced by the pushed one, even
+  // if the queue is not full. Otherwise behaves like `DropOldest`.
+  Merge,
+};
+
+struct AsyncQueueConfig {
+  // 0 means that the queue is unbounded.
+  size_t capacity = 0;
+  AsyncQueueOverflowPolicy overflowPolicy = AsyncQueueOverflowPolicy::Block;
+};
+
+struct AsyncQueueStats {
+  size_t depth = 0;
+  size_t maxDepth = 0;
+  size_t capacity = 0;
+  uint64_t processed = 0;
+  uint64_t dropped = 0;
+  uint64_t merged = 0;
+  // Time between pushing a job and the start of its execution.
+  double lastLatencyMs = 0;
+  double averageLatencyMs = 0;
+};
+
 struct AsyncQueueState {
+  using Clock = std::chrono::steady_clock;
+
+  struct Slot {
+    std::function<void()> job;
+    uint64_t mergeKey = 0;
+    Clock::time_point pushedAt;
+  };
+
+  explicit AsyncQueueState(const AsyncQueueConfig &config);
+
+  void pushBack(Slot &&slot);
+  Slot popFront();
+  void grow();
+
+  const AsyncQueueConfig config;
   std::atomic_bool running{true};
   std::mutex mutex;
   std::condition_variable cv;
-  std::queue<std::function<void()>> queue;
+  std::condition_variable notFullCv;
+  std::thread::id workerThreadId;
+  // Ring buffer of pending jobs, grown if the queue is unbounded or when the
+  // worker pushes to its own full `Block` queue.
+  std::vector<Slot> slots;
+  size_t head = 0;
+  size_t size = 0;
+  // Sequence number of the job at `head`, used to locate jobs to merge.
+  uint64_t headSequence = 0;
+  std::unordered_map<uint64_t, uint64_t> mergeKeySequences;
+  AsyncQueueStats stats;
+  double totalLatencyMs = 0;
 };
 
 class AsyncQueue {
  public:
-  explicit AsyncQueue(std::string name);
+  explicit AsyncQueue(std::string name, const AsyncQueueConfig &config = {});
 
   ~AsyncQueue();
 
-  void push(std::function<void()> &&job);
+  // Returns false if the job was dropped because the queue is full. Merge keys
+  // are only used with `AsyncQueueOverflowPolicy::Merge`, 0 means no key.
+  bool push(std::function<void()> &&job, uint64_t mergeKey = 0);
+
+  AsyncQueueStats getStats() const;
 
  private:
   const std::shared_ptr<AsyncQueueState> state_;
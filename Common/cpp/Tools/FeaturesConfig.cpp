@@ -2,4 +2,5 @@
 
 namespace reanimated {
 bool FeaturesConfig::_isLayoutAnimationEnabled = false;
+std::atomic<bool> FeaturesConfig::_isShareableDeduplicationEnabled{false};
 }
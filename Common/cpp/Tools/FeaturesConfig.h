@@ -1,4 +1,5 @@
 #pragma once
+#include <atomic>
 #include <string>
 
 namespace reanimated {
@@ -11,9 +12,19 @@ class FeaturesConfig {
   static inline void setLayoutAnimationEnabled(bool isLayoutAnimationEnabled) {
     _isLayoutAnimationEnabled = isLayoutAnimationEnabled;
   }
+  static inline bool isShareableDeduplicationEnabled() {
+    return _isShareableDeduplicationEnabled.load(std::memory_order_relaxed);
+  }
+  static inline void setShareableDeduplicationEnabled(
+      bool isShareableDeduplicationEnabled) {
+    _isShareableDeduplicationEnabled.store(
+        isShareableDeduplicationEnabled, std::memory_order_relaxed);
+  }
 
  private:
   static bool _isLayoutAnimationEnabled;
+  // Set on the JS thread and read by whichever thread makes shareables.
+  static std::atomic<bool> _isShareableDeduplicationEnabled;
 };
 
 } // namespace reanimated
@@ -0,0 +1,72 @@
+#include "FrameBudget.h"
+
+#include <algorithm>
+
+namespace reanimated {
+
+// Intervals between frame timestamps shorter than the minimum are ignored and
+// the interval is capped at 60 fps, so that timestamps slowed down by slow
+// animations don't inflate the budget.
+static constexpr double kMinFrameIntervalMs = 1000.0 / 240;
+static constexpr double kMaxFrameIntervalMs = 1000.0 / 60;
+
+// The part of the frame interval left for the frame callbacks.
+static constexpr double kCallbacksBudgetFraction = 0.75;
+
+// Weight of the latest callback in the average callback duration.
+static constexpr double kCallbackDurationWeight = 0.2;
+
+using Clock = std::chrono::steady_clock;
+using Milliseconds = std::chrono::duration<double, std::milli>;
+
+void FrameBudget::beginFrame(double timestampMs) {
+  if (lastTimestampMs_ >= 0 && timestampMs > lastTimestampMs_) {
+    intervalsMs_[nextIntervalIndex_] = timestampMs - lastTimestampMs_;
+    nextIntervalIndex_ = (nextIntervalIndex_ + 1) % kIntervalHistorySize;
+  }
+  lastTimestampMs_ = timestampMs;
+  budgetMs_ = getFrameIntervalMs() * kCallbacksBudgetFraction;
+  frameStartTime_ = Clock::now();
+  deadline_ = frameStartTime_ +
+      std::chrono::duration_cast<Clock::duration>(Milliseconds(budgetMs_));
+}
+
+bool FrameBudget::hasTimeForCallback() const {
+  return Clock::now() + Milliseconds(averageCallbackMs_) <= deadline_;
+}
+
+void FrameBudget::endCallback(std::chrono::steady_clock::time_point startTime) {
+  double durationMs = Milliseconds(Clock::now() - startTime).count();
+  averageCallbackMs_ +=
+      (durationMs - averageCallbackMs_) * kCallbackDurationWeight;
+}
+
+void FrameBudget::endFrame(size_t deferredCallbacks) {
+  double frameMs = Milliseconds(Clock::now() - frameStartTime_).count();
+  std::lock_guard<std::mutex> lock(statsMutex_);
+  stats_.frames++;
+  if (frameMs > budgetMs_) {
+    stats_.overBudgetFrames++;
+  }
+  stats_.deferredCallbacks += deferredCallbacks;
+  stats_.budgetMs = budgetMs_;
+  stats_.frameIntervalMs = getFrameIntervalMs();
+  stats_.longestFrameMs = std::max(stats_.longestFrameMs, frameMs);
+}
+
+FrameBudgetStats FrameBudget::getStats() const {
+  std::lock_guard<std::mutex> lock(statsMutex_);
+  return stats_;
+}
+
+double FrameBudget::getFrameIntervalMs() const {
+  double intervalMs = kMaxFrameIntervalMs;
+  for (auto recentIntervalMs : intervalsMs_) {
+    if (recentIntervalMs >= kMinFrameIntervalMs) {
+      intervalMs = std::min(intervalMs, recentIntervalMs);
+    }
+  }
+  return intervalMs;
+}
+
+} // namespace reanimated
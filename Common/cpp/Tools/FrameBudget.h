@@ -0,0 +1,64 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace reanimated {
+
+struct FrameBudgetStats {
+  uint64_t frames = 0;
+  // Frames whose callbacks took longer than the budget.
+  uint64_t overBudgetFrames = 0;
+  // Times a deferrable callback was postponed to the next frame.
+  uint64_t deferredCallbacks = 0;
+  double budgetMs = 0;
+  double frameIntervalMs = 0;
+  double longestFrameMs = 0;
+};
+
+// Keeps track of the time the frame callbacks of a single frame may take.
+//
+// The vsync interval is derived from the timestamps the platform passes to the
+// render callback: it's the shortest interval between consecutive frames seen
+// recently, as longer ones mean that frames were skipped. Callbacks get a part
+// of it, the rest is left for applying the updates and rendering. The deadline
+// is measured from the start of the frame on the steady clock, since the
+// platform timestamps may be scaled (e.g. by slow animations on iOS).
+//
+// Must only be used on the UI thread, except for `getStats`.
+class FrameBudget {
+ public:
+  void beginFrame(double timestampMs);
+
+  // Whether a callback is expected to finish before the deadline, based on the
+  // average duration of the callbacks measured with `endCallback` so far.
+  bool hasTimeForCallback() const;
+
+  // Records the duration of a callback that started at `startTime`.
+  void endCallback(std::chrono::steady_clock::time_point startTime);
+
+  void endFrame(size_t deferredCallbacks);
+
+  FrameBudgetStats getStats() const;
+
+ private:
+  double getFrameIntervalMs() const;
+
+  static constexpr size_t kIntervalHistorySize = 8;
+
+  std::array<double, kIntervalHistorySize> intervalsMs_{};
+  size_t nextIntervalIndex_ = 0;
+  double lastTimestampMs_ = -1;
+  double budgetMs_ = 0;
+  double averageCallbackMs_ = 0;
+  std::chrono::steady_clock::time_point frameStartTime_;
+  std::chrono::steady_clock::time_point deadline_;
+
+  mutable std::mutex statsMutex_; // Protects `stats_`.
+  FrameBudgetStats stats_;
+};
+
+} // namespace reanimated
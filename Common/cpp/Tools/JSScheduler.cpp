@@ -1,12 +1,106 @@
 #include "JSScheduler.h"
 
+#include <iterator>
 #include <utility>
 
 namespace reanimated {
 
-void JSScheduler::scheduleOnJS(std::function<void(jsi::Runtime &rt)> job) {
-  jsCallInvoker_->invokeAsync(
-      [job = std::move(job), &rt = rnRuntime_] { job(rt); });
+JSScheduler::Batch::Batch(const std::shared_ptr<JSScheduler> &jsScheduler)
+    : jsScheduler_(jsScheduler) {
+  jsScheduler_->beginBatch();
+}
+
+JSScheduler::Batch::~Batch() {
+  jsScheduler_->endBatch();
+}
+
+void JSScheduler::scheduleOnJS(Job job, const void *coalescingKey) {
+  std::unique_lock<std::mutex> lock(jobsMutex_);
+  if (coalescingKey != nullptr) {
+    auto it = coalescedJobIndices_.find(coalescingKey);
+    if (it != coalescedJobIndices_.end()) {
+      // Swap instead of assigning so that the replaced job, along with
+      // whatever it captures, is destroyed outside of the lock.
+      std::swap(jobs_[it->second].job, job);
+      lock.unlock();
+      return;
+    }
+    coalescedJobIndices_.emplace(coalescingKey, jobs_.size());
+  }
+  jobs_.push_back({std::move(job), coalescingKey});
+  if (!shouldRequestFlush()) {
+    return;
+  }
+  isFlushRequested_ = true;
+  lock.unlock();
+  requestFlush();
+}
+
+void JSScheduler::beginBatch() {
+  std::lock_guard<std::mutex> lock(jobsMutex_);
+  openBatches_++;
+}
+
+void JSScheduler::endBatch() {
+  {
+    std::lock_guard<std::mutex> lock(jobsMutex_);
+    openBatches_--;
+    if (!shouldRequestFlush()) {
+      return;
+    }
+    isFlushRequested_ = true;
+  }
+  requestFlush();
+}
+
+bool JSScheduler::shouldRequestFlush() const {
+  return openBatches_ == 0 && !isFlushRequested_ && !jobs_.empty();
+}
+
+void JSScheduler::requestFlush() {
+  jsCallInvoker_->invokeAsync([weakThis = weak_from_this()] {
+    if (auto jsScheduler = weakThis.lock()) {
+      jsScheduler->flush();
+    }
+  });
+}
+
+void JSScheduler::flush() {
+  std::vector<PendingJob> jobs;
+  {
+    std::lock_guard<std::mutex> lock(jobsMutex_);
+    std::swap(jobs, jobs_);
+    coalescedJobIndices_.clear();
+    isFlushRequested_ = false;
+  }
+  for (auto it = jobs.begin(); it != jobs.end(); it++) {
+    try {
+      it->job(rnRuntime_);
+    } catch (...) {
+      // Put back the jobs that didn't run yet so that an exception thrown by
+      // one of them doesn't drop the others, then let it propagate as before.
+      bool needsFlush;
+      {
+        std::lock_guard<std::mutex> lock(jobsMutex_);
+        jobs_.insert(
+            jobs_.begin(),
+            std::make_move_iterator(std::next(it)),
+            std::make_move_iterator(jobs.end()));
+        coalescedJobIndices_.clear();
+        for (size_t i = 0; i < jobs_.size(); i++) {
+          if (jobs_[i].coalescingKey != nullptr) {
+            coalescedJobIndices_[jobs_[i].coalescingKey] = i;
+          }
+        }
+        needsFlush = !isFlushRequested_ && !jobs_.empty();
+        isFlushRequested_ = isFlushRequested_ || needsFlush;
+      }
+      if (needsFlush) {
+        requestFlush();
+      }
+      throw;
+    }
+  }
 }
 
 } // namespace reanimated
@@ -3,23 +3,68 @@
 #include <ReactCommon/CallInvoker.h>
 #include <jsi/jsi.h>
 
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 using namespace facebook;
 
 namespace reanimated {
 
-class JSScheduler {
+// Delivers jobs to the RN runtime in batches. All jobs scheduled before the JS
+// thread gets to them run within a single `invokeAsync`, in the order they
+// were scheduled in.
+class JSScheduler : public std::enable_shared_from_this<JSScheduler> {
  public:
+  using Job = std::function<void(jsi::Runtime &rt)>;
+
+  // Holds back the delivery of jobs until the last open batch is closed, so
+  // that e.g. all jobs scheduled during a single frame reach the JS thread at
+  // once.
+  class Batch {
+   public:
+    explicit Batch(const std::shared_ptr<JSScheduler> &jsScheduler);
+    Batch(const Batch &) = delete;
+    Batch &operator=(const Batch &) = delete;
+    ~Batch();
+
+   private:
+    const std::shared_ptr<JSScheduler> jsScheduler_;
+  };
+
   explicit JSScheduler(
       jsi::Runtime &rnRuntime,
       const std::shared_ptr<facebook::react::CallInvoker> &jsCallInvoker)
       : rnRuntime_(rnRuntime), jsCallInvoker_(jsCallInvoker) {}
-  void scheduleOnJS(std::function<void(jsi::Runtime &rt)> job);
+
+  // If `coalescingKey` is not null and a job with the same key is still
+  // waiting to be delivered, `job` takes its place instead of being appended.
+  void scheduleOnJS(Job job, const void *coalescingKey = nullptr);
 
  protected:
   jsi::Runtime &rnRuntime_;
   const std::shared_ptr<facebook::react::CallInvoker> jsCallInvoker_;
+
+ private:
+  struct PendingJob {
+    Job job;
+    const void *coalescingKey;
+  };
+
+  void beginBatch();
+  void endBatch();
+  // Must be called with `jobsMutex_` held.
+  bool shouldRequestFlush() const;
+  void requestFlush();
+  void flush();
+
+  std::mutex jobsMutex_; // Protects all the fields below.
+  std::vector<PendingJob> jobs_;
+  std::unordered_map<const void *, size_t> coalescedJobIndices_;
+  size_t openBatches_ = 0;
+  bool isFlushRequested_ = false;
 };
 
 } // namespace reanimated
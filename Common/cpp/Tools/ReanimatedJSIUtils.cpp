@@ -1,10 +1,108 @@
 #include "ReanimatedJSIUtils.h"
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
 #include <vector>
 
 using namespace facebook;
 
 namespace reanimated::jsi_utils {
 
+// Serves the functions to the accessors defined by `kDefineLazyGlobals`.
+class LazyJsiFunctions::Functions : public jsi::HostObject {
+ public:
+  explicit Functions(std::vector<std::unique_ptr<Entry>> &&entries)
+      : entries_(std::move(entries)) {}
+
+  jsi::Value get(jsi::Runtime &rt, const jsi::PropNameID &propName) override {
+    auto name = propName.utf8(rt);
+    for (const auto &entry : entries_) {
+      if (entry->name == name) {
+        return jsi::Function::createFromHostFunction(
+            rt, propName, entry->argsCount, entry->makeHostFunction());
+      }
+    }
+    return jsi::Value::undefined();
+  }
+
+  std::vector<jsi::PropNameID> getPropertyNames(jsi::Runtime &rt) override {
+    std::vector<jsi::PropNameID> propertyNames;
+    propertyNames.reserve(entries_.size());
+    for (const auto &entry : entries_) {
+      propertyNames.push_back(jsi::PropNameID::forUtf8(rt, entry->name));
+    }
+    return propertyNames;
+  }
+
+ private:
+  const std::vector<std::unique_ptr<Entry>> entries_;
+};
+
+// Called with the global object, the host object with the functions and the
+// names of the functions joined with commas. Reading a global takes its
+// function from the host object and assigning it sets the new value, either
+// way the accessor is replaced with a plain value.
+static constexpr const char *kDefineLazyGlobals = R"((
+function (global, functions, names) {
+  function defineLazyGlobal(name) {
+    function define(value) {
+      Object.defineProperty(global, name, {
+        value: value,
+        writable: true,
+        enumerable: true,
+        configurable: true,
+      });
+      return value;
+    }
+    Object.defineProperty(global, name, {
+      get: function () {
+        return define(functions[name]);
+      },
+      set: define,
+      enumerable: true,
+      configurable: true,
+    });
+  }
+  names.split(',').forEach(defineLazyGlobal);
+}
+))";
+
+static std::shared_ptr<const jsi::PreparedJavaScript> getDefineLazyGlobals(
+    jsi::Runtime &rt) {
+  // Prepared once per process, like worklets in WorkletCodeCache.
+  static std::mutex mutex;
+  static std::shared_ptr<const jsi::PreparedJavaScript> preparedCode;
+  std::lock_guard<std::mutex> lock(mutex);
+  if (preparedCode == nullptr) {
+    preparedCode = rt.prepareJavaScript(
+        std::make_shared<const jsi::StringBuffer>(kDefineLazyGlobals),
+        "LazyJsiFunctions");
+  }
+  return preparedCode;
+}
+
+void LazyJsiFunctions::install(jsi::Runtime &rt) {
+  std::string names;
+  for (const auto &entry : entries_) {
+    if (!names.empty()) {
+      names += ',';
+    }
+    names += entry->name;
+  }
+  auto functions = jsi::Object::createFromHostObject(
+      rt, std::make_shared<Functions>(std::move(entries_)));
+  entries_.clear();
+  rt.evaluatePreparedJavaScript(getDefineLazyGlobals(rt))
+      .asObject(rt)
+      .asFunction(rt)
+      .call(
+          rt,
+          rt.global(),
+          functions,
+          jsi::String::createFromUtf8(rt, names));
+}
+
 jsi::Array convertStringToArray(
     jsi::Runtime &rt,
     const std::string &value,
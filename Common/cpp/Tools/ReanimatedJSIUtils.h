@@ -1,10 +1,14 @@
 #pragma once
 
 #include <jsi/jsi.h>
+#include <memory>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <tuple>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 using namespace facebook;
 
@@ -46,126 +50,184 @@ inline jsi::Value const &get<jsi::Value const &>(
   return *value;
 }
 
-// `convertArgs` functions take a variadic template parameter of target (C++)
-// argument types `Targs` and a `jsi::Value` array `args`, and converts `args`
-// to a tuple of typed C++ arguments to be passed to the native implementation.
-// This is accomplished by dispatching (at compile time) to the correct
-// implementation based on the first type of `Targs`, using SFINAE to select the
-// correct specialization, and concatenating with the result of recursion on the
-// rest of `Targs`
-
-// BEGIN implementations for `convertArgs` specializations.
-// specialization for empty `Targs` - returns an empty tuple
-template <typename... Args>
-inline std::enable_if_t<(sizeof...(Args) == 0), std::tuple<>> convertArgs(
-    jsi::Runtime &,
-    const jsi::Value *) {
-  return std::make_tuple();
-}
-
-// calls `get<First>` on the first argument to retrieve the native type,
-// then calls recursively on the rest of `args`
-// and returns the concatenation of results
-template <typename T, typename... Rest>
-inline std::tuple<T, Rest...> convertArgs(
-    jsi::Runtime &rt,
-    const jsi::Value *args) {
-  auto arg = std::tuple<T>(get<T>(rt, args));
-  auto rest = convertArgs<Rest...>(rt, std::next(args));
-  return std::tuple_cat(std::move(arg), std::move(rest));
-}
-// END implementations for `convertArgs` specializations.
+// `function_traits` describes the signature of a callable, i.e. a function
+// pointer or an object with a single, non-template `operator()` such as a
+// lambda or `std::function`
+template <typename Fun>
+struct function_traits : function_traits<decltype(&Fun::operator())> {};
 
-// returns a tuple with the result of casting `args` to appropriate
-// native C++ types needed to call `function`
 template <typename Ret, typename... Args>
-std::tuple<Args...> getArgsForFunction(
-    std::function<Ret(Args...)>,
-    jsi::Runtime &rt,
-    const jsi::Value *args,
-    const size_t count) {
-  assert(sizeof...(Args) == count);
-  return convertArgs<Args...>(rt, args);
-}
+struct function_traits<Ret (*)(Args...)> {
+  using result_type = Ret;
+  using args_type = std::tuple<Args...>;
+};
 
-// returns a tuple with the result of casting `args` to appropriate
-// native C++ types needed to call `function`,
-// passing `rt` as the first argument
 template <typename Ret, typename... Args>
-std::tuple<jsi::Runtime &, Args...> getArgsForFunction(
-    std::function<Ret(jsi::Runtime &, Args...)>,
-    jsi::Runtime &rt,
-    const jsi::Value *args,
-    const size_t count) {
-  assert(sizeof...(Args) == count);
-  return std::tuple_cat(std::tie(rt), convertArgs<Args...>(rt, args));
-}
+struct function_traits<Ret(Args...)> : function_traits<Ret (*)(Args...)> {};
 
-// calls `function` with `args`
-template <typename Ret, typename... Args>
-inline jsi::Value apply(
-    std::function<Ret(Args...)> function,
-    std::tuple<Args...> args) {
-  return std::apply(function, std::move(args));
-}
+template <typename Class, typename Ret, typename... Args>
+struct function_traits<Ret (Class::*)(Args...)>
+    : function_traits<Ret (*)(Args...)> {};
+
+template <typename Class, typename Ret, typename... Args>
+struct function_traits<Ret (Class::*)(Args...) const>
+    : function_traits<Ret (*)(Args...)> {};
+
+// `ArgsConverter` calls a native function with `args` converted to its
+// argument types `Args`. The conversions are expanded at compile time, one
+// `get` per argument, without building any intermediate tuple.
+template <typename Args>
+struct ArgsConverter;
 
-// calls void-returning `function` with `args`,
-// and returns `undefined`
 template <typename... Args>
-inline jsi::Value apply(
-    std::function<void(Args...)> function,
-    std::tuple<Args...> args) {
-  std::apply(function, std::move(args));
-  return jsi::Value::undefined();
+struct ArgsConverter<std::tuple<Args...>> {
+  static constexpr size_t count = sizeof...(Args);
+
+  template <typename Fun, size_t... I>
+  static inline decltype(auto) call(
+      Fun &function,
+      jsi::Runtime &rt,
+      const jsi::Value *args,
+      std::index_sequence<I...>) {
+    return function(get<Args>(rt, args + I)...);
+  }
+};
+
+// specialization for functions that take `Runtime &` as the first argument,
+// which is not counted as a JS argument
+template <typename... Args>
+struct ArgsConverter<std::tuple<jsi::Runtime &, Args...>> {
+  static constexpr size_t count = sizeof...(Args);
+
+  template <typename Fun, size_t... I>
+  static inline decltype(auto) call(
+      Fun &function,
+      jsi::Runtime &rt,
+      const jsi::Value *args,
+      std::index_sequence<I...>) {
+    return function(rt, get<Args>(rt, args + I)...);
+  }
+};
+
+template <typename Fun>
+using ArgsConverterFor =
+    ArgsConverter<typename function_traits<std::decay_t<Fun>>::args_type>;
+
+// returns the number of JS arguments `Fun` expects
+template <typename Fun>
+constexpr unsigned int argsCountOf() {
+  return ArgsConverterFor<Fun>::count;
 }
 
-// returns a function with JSI calling convention
-// from a native function `function`
+// returns a function with JSI calling convention from a native function
+// `function`, which is stored and called directly rather than through
+// a `std::function`
 template <typename Fun>
 jsi::HostFunctionType createHostFunction(Fun function) {
-  return [function](
+  using Converter = ArgsConverterFor<Fun>;
+  using Ret = typename function_traits<Fun>::result_type;
+  return [function = std::move(function)](
              jsi::Runtime &rt,
              const jsi::Value &,
              const jsi::Value *args,
-             const size_t count) {
-    auto argz = getArgsForFunction(function, rt, args, count);
-    return apply(function, std::move(argz));
+             const size_t count) mutable -> jsi::Value {
+    if (count < Converter::count) {
+      throw jsi::JSINativeException(
+          "[Reanimated] Expected " + std::to_string(Converter::count) +
+          " arguments, got " + std::to_string(count) + ".");
+    }
+    assert(Converter::count == count);
+    auto indices = std::make_index_sequence<Converter::count>();
+    if constexpr (std::is_void_v<Ret>) {
+      Converter::call(function, rt, args, indices);
+      return jsi::Value::undefined();
+    } else {
+      return Converter::call(function, rt, args, indices);
+    }
   };
 }
 
-// used to determine if `function<Ret(Args...)>`
-// takes `Runtime &` as its first argument
-template <typename... Args>
-struct takes_runtime {
-  static constexpr size_t value = 0;
-};
-
-// specialization for `function<Ret(Runtime &, Rest...)`
-template <typename... Rest>
-struct takes_runtime<jsi::Runtime &, Rest...> {
-  static constexpr size_t value = 1;
-};
-
 // creates a JSI compatible function from `function`
 // and installs it as a global function named `name`
 // in the `rt` JS runtime
-template <typename Ret, typename... Args>
-void installJsiFunction(
-    jsi::Runtime &rt,
-    std::string_view name,
-    std::function<Ret(Args...)> function) {
-  auto clb = createHostFunction(function);
-  auto argsCount = sizeof...(Args) - takes_runtime<Args...>::value;
+template <typename Fun>
+void installJsiFunction(jsi::Runtime &rt, std::string_view name, Fun function) {
+  auto argsCount = argsCountOf<Fun>();
+  auto clb = createHostFunction(std::move(function));
   jsi::Value jsiFunction = jsi::Function::createFromHostFunction(
       rt, jsi::PropNameID::forAscii(rt, name.data()), argsCount, clb);
   rt.global().setProperty(rt, name.data(), jsiFunction);
 }
 
-// this should take care of passing types convertible to `function`
-template <typename Fun>
-void installJsiFunction(jsi::Runtime &rt, std::string_view name, Fun function) {
-  installJsiFunction(rt, name, std::function(std::forward<Fun>(function)));
-}
+// Collects global functions and installs them in a runtime lazily. Only the
+// native callables are kept until a global is first read, at which point its
+// host function is created and the global is redefined as a plain value.
+// Runtimes don't pay for the functions they never use.
+//
+// The functions are served by a single host object. The globals are defined
+// in JS, as accessors that read the function from the host object, so that
+// installing them takes a constant number of JSI calls.
+class LazyJsiFunctions {
+ public:
+  // Same as `installJsiFunction`, but deferred until the global is read.
+  template <typename Fun>
+  void add(std::string_view name, Fun function) {
+    entries_.push_back(
+        std::make_unique<CallableEntry<Fun>>(name, std::move(function)));
+  }
+
+  void add(
+      std::string_view name,
+      unsigned int argsCount,
+      jsi::HostFunctionType hostFunction) {
+    entries_.push_back(std::make_unique<HostFunctionEntry>(
+        name, argsCount, std::move(hostFunction)));
+  }
+
+  // Defines the globals of all added functions on `rt`.
+  void install(jsi::Runtime &rt);
+
+ private:
+  struct Entry {
+    Entry(std::string_view name, unsigned int argsCount)
+        : name(name), argsCount(argsCount) {}
+    virtual ~Entry() = default;
+    virtual jsi::HostFunctionType makeHostFunction() const = 0;
+
+    const std::string name;
+    const unsigned int argsCount;
+  };
+
+  template <typename Fun>
+  struct CallableEntry final : Entry {
+    CallableEntry(std::string_view name, Fun function)
+        : Entry(name, argsCountOf<Fun>()), function(std::move(function)) {}
+
+    jsi::HostFunctionType makeHostFunction() const override {
+      return createHostFunction(function);
+    }
+
+    const Fun function;
+  };
+
+  struct HostFunctionEntry final : Entry {
+    HostFunctionEntry(
+        std::string_view name,
+        unsigned int argsCount,
+        jsi::HostFunctionType hostFunction)
+        : Entry(name, argsCount), hostFunction(std::move(hostFunction)) {}
+
+    jsi::HostFunctionType makeHostFunction() const override {
+      return hostFunction;
+    }
+
+    const jsi::HostFunctionType hostFunction;
+  };
+
+  class Functions;
+
+  std::vector<std::unique_ptr<Entry>> entries_;
+};
 
 jsi::Array convertStringToArray(
     jsi::Runtime &rt,
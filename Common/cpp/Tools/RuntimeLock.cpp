@@ -0,0 +1,53 @@
+#include "RuntimeLock.h"
+
+namespace reanimated {
+
+void RuntimeLock::recordWait(Clock::duration wait) {
+  totalWait_.fetch_add(wait.count(), std::memory_order_relaxed);
+}
+
+void RuntimeLock::recordHold(Clock::duration hold) {
+  // written only while holding `mutex_`, hence no compare-exchange
+  if (hold > longestHold_.load(std::memory_order_relaxed)) {
+    longestHold_.store(hold, std::memory_order_relaxed);
+  }
+}
+
+void RuntimeLock::lockContended() {
+  auto start = Clock::now();
+  mutex_.lock();
+  recordWait(Clock::now() - start);
+  contendedAcquisitions_.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool RuntimeLock::lockContendedFor(Clock::duration timeout) {
+  auto start = Clock::now();
+  auto locked =
+      timeout > Clock::duration::zero() && mutex_.try_lock_for(timeout);
+  recordWait(Clock::now() - start);
+  if (locked) {
+    contendedAcquisitions_.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    timedOutAcquisitions_.fetch_add(1, std::memory_order_relaxed);
+  }
+  return locked;
+}
+
+static double toMs(std::chrono::steady_clock::duration duration) {
+  return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+RuntimeLockStats RuntimeLock::getStats() const {
+  RuntimeLockStats stats;
+  stats.acquisitions = acquisitions_.load(std::memory_order_relaxed);
+  stats.contendedAcquisitions =
+      contendedAcquisitions_.load(std::memory_order_relaxed);
+  stats.timedOutAcquisitions =
+      timedOutAcquisitions_.load(std::memory_order_relaxed);
+  stats.totalWaitMs = toMs(
+      Clock::duration(totalWait_.load(std::memory_order_relaxed)));
+  stats.longestHoldMs = toMs(longestHold_.load(std::memory_order_relaxed));
+  return stats;
+}
+
+} // namespace reanimated
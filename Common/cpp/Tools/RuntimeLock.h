@@ -0,0 +1,139 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+namespace reanimated {
+
+struct RuntimeLockStats {
+  // Outermost acquisitions only, recursive ones are not counted.
+  uint64_t acquisitions = 0;
+  // Acquisitions that had to wait for another thread to release the lock.
+  uint64_t contendedAcquisitions = 0;
+  // Timed acquisitions that gave up before the lock was released.
+  uint64_t timedOutAcquisitions = 0;
+  // Includes the time spent in timed acquisitions that timed out.
+  double totalWaitMs = 0;
+  // Sampled, see `RuntimeLock`, so shorter holds may be missed.
+  double longestHoldMs = 0;
+};
+
+// A recursive lock for runtimes shared between threads, meant for the case
+// where one thread (the UI thread) holds it almost all the time and others
+// (e.g. `executeSync` on the JS thread) only rarely need it.
+//
+// Re-entering the lock on the thread that already holds it only bumps a
+// counter and an uncontended acquisition costs a single `try_lock`, so callers
+// can take it around every JSI call as well as around whole worklets. Only
+// acquisitions that actually have to wait pay for measuring the wait. Hold
+// times are measured for contended acquisitions and for every
+// `kHoldSamplingInterval`-th one, so that the clock isn't read on the fast
+// path.
+//
+// Satisfies TimedLockable, so it can be used with `std::unique_lock` and
+// friends.
+class RuntimeLock {
+ public:
+  void lock() {
+    auto self = std::this_thread::get_id();
+    // Only the owner ever stores its own id here, so another thread can't
+    // see it even with a relaxed load.
+    if (owner_.load(std::memory_order_relaxed) == self) {
+      depth_++;
+      return;
+    }
+    if (mutex_.try_lock()) {
+      acquired(self);
+      return;
+    }
+    lockContended();
+    acquired(self, true);
+  }
+
+  bool try_lock() {
+    auto self = std::this_thread::get_id();
+    if (owner_.load(std::memory_order_relaxed) == self) {
+      depth_++;
+      return true;
+    }
+    if (!mutex_.try_lock()) {
+      return false;
+    }
+    acquired(self);
+    return true;
+  }
+
+  template <typename Rep, typename Period>
+  bool try_lock_for(const std::chrono::duration<Rep, Period> &timeout) {
+    auto self = std::this_thread::get_id();
+    if (owner_.load(std::memory_order_relaxed) == self) {
+      depth_++;
+      return true;
+    }
+    if (mutex_.try_lock()) {
+      acquired(self);
+      return true;
+    }
+    if (!lockContendedFor(
+            std::chrono::duration_cast<Clock::duration>(timeout))) {
+      return false;
+    }
+    acquired(self, true);
+    return true;
+  }
+
+  void unlock() {
+    if (--depth_ > 0) {
+      return;
+    }
+    if (isHoldSampled_) {
+      recordHold(Clock::now() - acquiredAt_);
+    }
+    owner_.store(std::thread::id(), std::memory_order_relaxed);
+    mutex_.unlock();
+  }
+
+  RuntimeLockStats getStats() const;
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  static constexpr uint64_t kHoldSamplingInterval = 64;
+
+  void acquired(std::thread::id self, bool contended = false) {
+    owner_.store(self, std::memory_order_relaxed);
+    depth_ = 1;
+    // written only while holding `mutex_`, hence no read-modify-write
+    auto acquisitions = acquisitions_.load(std::memory_order_relaxed) + 1;
+    acquisitions_.store(acquisitions, std::memory_order_relaxed);
+    isHoldSampled_ = contended || acquisitions % kHoldSamplingInterval == 0;
+    if (isHoldSampled_) {
+      acquiredAt_ = Clock::now();
+    }
+  }
+
+  void lockContended();
+  bool lockContendedFor(Clock::duration timeout);
+  void recordWait(Clock::duration wait);
+  void recordHold(Clock::duration hold);
+
+  std::timed_mutex mutex_;
+  std::atomic<std::thread::id> owner_{};
+  // Accessed only by the owner.
+  size_t depth_ = 0;
+  bool isHoldSampled_ = false;
+  Clock::time_point acquiredAt_;
+
+  std::atomic<uint64_t> acquisitions_{0};
+  std::atomic<uint64_t> contendedAcquisitions_{0};
+  std::atomic<uint64_t> timedOutAcquisitions_{0};
+  // Updated by threads that failed to acquire the lock as well, hence kept in
+  // ticks of `Clock` to allow for `fetch_add`.
+  std::atomic<Clock::rep> totalWait_{0};
+  std::atomic<Clock::duration> longestHold_{Clock::duration::zero()};
+};
+
+} // namespace reanimated
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace reanimated {
+
+// A move-only replacement for `std::function<void()>` that keeps callables of
+// up to `InlineSize` bytes in place, while std::function allocates anything
+// bigger than a couple of pointers on the heap. Larger callables are still
+// supported and are allocated on the heap.
+template <size_t InlineSize>
+class SmallFunction {
+  static_assert(InlineSize >= sizeof(void *));
+
+ public:
+  SmallFunction() = default;
+
+  template <
+      typename Function,
+      typename = std::enable_if_t<
+          !std::is_same_v<std::decay_t<Function>, SmallFunction>>>
+  SmallFunction(Function &&function) { // NOLINT(runtime/explicit)
+    using Callable = std::decay_t<Function>;
+    if constexpr (fitsInline<Callable>) {
+      new (&storage_) Callable(std::forward<Function>(function));
+      operations_ = &inlineOperations<Callable>;
+    } else {
+      new (&storage_)
+          Callable *(new Callable(std::forward<Function>(function)));
+      operations_ = &heapOperations<Callable>;
+    }
+  }
+
+  SmallFunction(SmallFunction &&other) noexcept {
+    moveFrom(other);
+  }
+
+  SmallFunction &operator=(SmallFunction &&other) noexcept {
+    if (this != &other) {
+      reset();
+      moveFrom(other);
+    }
+    return *this;
+  }
+
+  SmallFunction(const SmallFunction &) = delete;
+  SmallFunction &operator=(const SmallFunction &) = delete;
+
+  ~SmallFunction() {
+    reset();
+  }
+
+  void operator()() {
+    operations_->invoke(&storage_);
+  }
+
+  explicit operator bool() const {
+    return operations_ != nullptr;
+  }
+
+ private:
+  struct Operations {
+    void (*invoke)(void *storage);
+    // Moves the callable to `destination` and destroys the source.
+    void (*move)(void *destination, void *source);
+    void (*destroy)(void *storage);
+  };
+
+  template <typename Callable>
+  static constexpr bool fitsInline = sizeof(Callable) <= InlineSize &&
+      alignof(Callable) <= alignof(std::max_align_t) &&
+      std::is_nothrow_move_constructible_v<Callable>;
+
+  template <typename Callable>
+  static constexpr Operations inlineOperations = {
+      [](void *storage) { (*static_cast<Callable *>(storage))(); },
+      [](void *destination, void *source) {
+        new (destination) Callable(std::move(*static_cast<Callable *>(source)));
+        static_cast<Callable *>(source)->~Callable();
+      },
+      [](void *storage) { static_cast<Callable *>(storage)->~Callable(); },
+  };
+
+  template <typename Callable>
+  static constexpr Operations heapOperations = {
+      [](void *storage) { (**static_cast<Callable **>(storage))(); },
+      [](void *destination, void *source) {
+        new (destination) Callable *(*static_cast<Callable **>(source));
+      },
+      [](void *storage) { delete *static_cast<Callable **>(storage); },
+  };
+
+  void moveFrom(SmallFunction &other) {
+    operations_ = other.operations_;
+    if (operations_ != nullptr) {
+      operations_->move(&storage_, &other.storage_);
+      other.operations_ = nullptr;
+    }
+  }
+
+  void reset() {
+    if (operations_ != nullptr) {
+      operations_->destroy(&storage_);
+      operations_ = nullptr;
+    }
+  }
+
+  const Operations *operations_ = nullptr;
+  alignas(std::max_align_t) unsigned char storage_[InlineSize];
+};
+
+} // namespace reanimated
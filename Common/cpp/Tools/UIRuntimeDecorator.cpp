@@ -14,6 +14,7 @@ void UIRuntimeDecorator::decorate(
     const MeasureFunction measure,
     const DispatchCommandFunction dispatchCommand,
     const RequestAnimationFrameFunction requestAnimationFrame,
+    const RequestAnimationFrameFunction requestDeferrableAnimationFrame,
     const GetAnimationTimestampFunction getAnimationTimestamp,
     const SetGestureStateFunction setGestureState,
     const ProgressLayoutAnimationFunction progressLayoutAnimation,
@@ -21,20 +22,18 @@ void UIRuntimeDecorator::decorate(
     const MaybeFlushUIUpdatesQueueFunction maybeFlushUIUpdatesQueue) {
   uiRuntime.global().setProperty(uiRuntime, "_UI", true);
 
+  jsi_utils::LazyJsiFunctions functions;
+
 #ifdef RCT_NEW_ARCH_ENABLED
-  jsi_utils::installJsiFunction(uiRuntime, "_updatePropsFabric", updateProps);
-  jsi_utils::installJsiFunction(
-      uiRuntime, "_removeFromPropsRegistry", removeFromPropsRegistry);
-  jsi_utils::installJsiFunction(
-      uiRuntime, "_dispatchCommandFabric", dispatchCommand);
-  jsi_utils::installJsiFunction(uiRuntime, "_measureFabric", measure);
+  functions.add("_updatePropsFabric", updateProps);
+  functions.add("_removeFromPropsRegistry", removeFromPropsRegistry);
+  functions.add("_dispatchCommandFabric", dispatchCommand);
+  functions.add("_measureFabric", measure);
 #else
-  jsi_utils::installJsiFunction(uiRuntime, "_updatePropsPaper", updateProps);
-  jsi_utils::installJsiFunction(
-      uiRuntime, "_dispatchCommandPaper", dispatchCommand);
-  jsi_utils::installJsiFunction(uiRuntime, "_scrollToPaper", scrollTo);
-  jsi_utils::installJsiFunction(
-      uiRuntime,
+  functions.add("_updatePropsPaper", updateProps);
+  functions.add("_dispatchCommandPaper", dispatchCommand);
+  functions.add("_scrollToPaper", scrollTo);
+  functions.add(
       "_measurePaper",
       [measure](jsi::Runtime &rt, int viewTag) -> jsi::Value {
         auto result = measure(viewTag);
@@ -46,19 +45,18 @@ void UIRuntimeDecorator::decorate(
       });
 #endif // RCT_NEW_ARCH_ENABLED
 
-  jsi_utils::installJsiFunction(
-      uiRuntime, "requestAnimationFrame", requestAnimationFrame);
-  jsi_utils::installJsiFunction(
-      uiRuntime, "_getAnimationTimestamp", getAnimationTimestamp);
+  functions.add("requestAnimationFrame", requestAnimationFrame);
+  functions.add(
+      "_requestDeferrableAnimationFrame", requestDeferrableAnimationFrame);
+  functions.add("_getAnimationTimestamp", getAnimationTimestamp);
+
+  functions.add("_notifyAboutProgress", progressLayoutAnimation);
+  functions.add("_notifyAboutEnd", endLayoutAnimation);
 
-  jsi_utils::installJsiFunction(
-      uiRuntime, "_notifyAboutProgress", progressLayoutAnimation);
-  jsi_utils::installJsiFunction(
-      uiRuntime, "_notifyAboutEnd", endLayoutAnimation);
+  functions.add("_setGestureState", setGestureState);
+  functions.add("_maybeFlushUIUpdatesQueue", maybeFlushUIUpdatesQueue);
 
-  jsi_utils::installJsiFunction(uiRuntime, "_setGestureState", setGestureState);
-  jsi_utils::installJsiFunction(
-      uiRuntime, "_maybeFlushUIUpdatesQueue", maybeFlushUIUpdatesQueue);
+  functions.install(uiRuntime);
 }
 
 } // namespace reanimated
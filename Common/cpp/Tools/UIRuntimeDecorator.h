@@ -24,6 +24,7 @@ class UIRuntimeDecorator {
       const MeasureFunction measure,
       const DispatchCommandFunction dispatchCommand,
       const RequestAnimationFrameFunction requestAnimationFrame,
+      const RequestAnimationFrameFunction requestDeferrableAnimationFrame,
       const GetAnimationTimestampFunction getAnimationTimestamp,
       const SetGestureStateFunction setGestureState,
       const ProgressLayoutAnimationFunction progressLayoutAnimation,
@@ -5,15 +5,78 @@
 
 namespace reanimated {
 
-void UIScheduler::scheduleOnUI(std::function<void()> job) {
-  uiJobs_.push(std::move(job));
+void UIScheduler::scheduleOnUI(UIJob job, UILane lane) {
+  {
+    std::lock_guard<std::mutex> lock(uiJobsMutex_);
+    if (lane == UILane::Urgent) {
+      urgentJobs_.push_back(std::move(job));
+    } else {
+      deferrableJobs_.push_back({std::move(job), Clock::now()});
+    }
+  }
+  if (!scheduledOnUI_.exchange(true)) {
+    requestTriggerUI();
+  }
 }
 
 void UIScheduler::triggerUI() {
   scheduledOnUI_ = false;
-  while (!uiJobs_.empty()) {
-    const auto job = uiJobs_.pop();
-    job();
+  const auto deadline = Clock::now() + kDeferrableJobsBudget;
+  runUrgentJobs();
+  while (!pendingDeferrableJobs_.empty()) {
+    const auto now = Clock::now();
+    auto &next = pendingDeferrableJobs_.front();
+    if (now >= deadline && now - next.scheduledAt < kMaxDeferrableJobDelay) {
+      break;
+    }
+    auto job = std::move(next.job);
+    pendingDeferrableJobs_.pop_front();
+    // as with the urgent jobs, the remaining ones run on the next trigger
+    try {
+      job();
+    } catch (...) {
+      if (!scheduledOnUI_.exchange(true)) {
+        requestTriggerUI();
+      }
+      throw;
+    }
+    // urgent jobs scheduled in the meantime don't wait for the deferrable ones
+    runUrgentJobs();
+  }
+  // The leftovers get a fresh budget on the next turn of the UI loop, which
+  // lets the platform handle input and render in between.
+  if (!pendingDeferrableJobs_.empty() && !scheduledOnUI_.exchange(true)) {
+    requestTriggerUI();
+  }
+}
+
+void UIScheduler::runUrgentJobs() {
+  // jobs may schedule more jobs, we run them in the same pass
+  while (true) {
+    if (nextRunningJob_ == runningJobs_.size()) {
+      runningJobs_.clear();
+      nextRunningJob_ = 0;
+      std::lock_guard<std::mutex> lock(uiJobsMutex_);
+      for (auto &deferrableJob : deferrableJobs_) {
+        pendingDeferrableJobs_.push_back(std::move(deferrableJob));
+      }
+      deferrableJobs_.clear();
+      if (urgentJobs_.empty()) {
+        return;
+      }
+      std::swap(urgentJobs_, runningJobs_);
+    }
+    // The job is taken out of the batch before it runs, so if it throws, it
+    // can't run again and the rest of the batch runs on the next trigger.
+    auto job = std::move(runningJobs_[nextRunningJob_++]);
+    try {
+      job();
+    } catch (...) {
+      if (!scheduledOnUI_.exchange(true)) {
+        requestTriggerUI();
+      }
+      throw;
+    }
   }
 }
 
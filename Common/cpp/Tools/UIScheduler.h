@@ -3,21 +3,75 @@
 #include <ReactCommon/CallInvoker.h>
 
 #include <atomic>
+#include <chrono>
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <vector>
 
-#include "ThreadSafeQueue.h"
+#include "SmallFunction.h"
 
 namespace reanimated {
 
+// Most jobs capture a couple of shared pointers and ids, so they fit in place.
+using UIJob = SmallFunction<64>;
+
+enum class UILane {
+  // Runs as soon as the UI thread picks up the queue, e.g. worklets that
+  // drive animations and gestures.
+  Urgent,
+  // Bookkeeping that runs only when the current trigger has time to spare,
+  // after all urgent jobs. Jobs in this lane still run in the order they were
+  // scheduled in and are never postponed for longer than
+  // `kMaxDeferrableJobDelay`.
+  //
+  // Deferring a job only yields the UI thread until the next trigger, which
+  // the platform runs on the next turn of the UI loop rather than in the next
+  // frame. Jobs whose order relative to platform callbacks (e.g. events)
+  // matters must stay urgent.
+  Deferrable,
+};
+
 class UIScheduler {
  public:
-  virtual void scheduleOnUI(std::function<void()> job);
+  virtual void scheduleOnUI(UIJob job, UILane lane = UILane::Urgent);
   virtual void triggerUI();
   virtual ~UIScheduler() = default;
 
  protected:
+  // Called when there are jobs waiting and `triggerUI` is not scheduled yet.
+  // Platforms should make the UI thread call `triggerUI` soon after.
+  virtual void requestTriggerUI() {}
+
   std::atomic<bool> scheduledOnUI_{false};
-  ThreadSafeQueue<std::function<void()>> uiJobs_;
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  // How long a single `triggerUI` can run before it stops picking up
+  // deferrable jobs, which is a fraction of a 60 FPS frame.
+  static constexpr auto kDeferrableJobsBudget = std::chrono::milliseconds(4);
+  static constexpr auto kMaxDeferrableJobDelay = std::chrono::milliseconds(100);
+
+  struct DeferrableJob {
+    UIJob job;
+    Clock::time_point scheduledAt;
+  };
+
+  void runUrgentJobs();
+
+  // Producers only append to the queues under the lock, while `triggerUI`
+  // swaps out the whole batch at once and runs it without holding the lock.
+  std::mutex uiJobsMutex_;
+  std::vector<UIJob> urgentJobs_;
+  std::vector<DeferrableJob> deferrableJobs_;
+  // Only accessed on the UI thread, kept to reuse its capacity.
+  std::vector<UIJob> runningJobs_;
+  // Index of the next job in `runningJobs_` to run.
+  size_t nextRunningJob_ = 0;
+  // Deferrable jobs taken out of `deferrableJobs_` that didn't run yet, only
+  // accessed on the UI thread.
+  std::deque<DeferrableJob> pendingDeferrableJobs_;
 };
 
 } // namespace reanimated
@@ -0,0 +1,47 @@
+import type { WorkletRuntime } from '../src';
+import { runOnRuntime } from '../src';
+import NativeReanimatedModule from '../src/reanimated2/NativeReanimated';
+
+describe('runOnRuntime', () => {
+  const workletRuntime = {} as WorkletRuntime;
+  let scheduleOnRuntime: jest.SpyInstance;
+
+  beforeEach(() => {
+    scheduleOnRuntime = jest
+      .spyOn(NativeReanimatedModule, 'scheduleOnRuntime')
+      .mockImplementation();
+  });
+
+  afterEach(() => {
+    jest.restoreAllMocks();
+  });
+
+  function getMergeTargets() {
+    return scheduleOnRuntime.mock.calls.map((call) => call[2]);
+  }
+
+  it('merges calls of the same worklet', () => {
+    const worklet = (value: number) => {
+      'worklet';
+      return value;
+    };
+    runOnRuntime(workletRuntime, worklet)(1);
+    runOnRuntime(workletRuntime, worklet)(2);
+    const [first, second] = getMergeTargets();
+    expect(first).toBe(worklet);
+    expect(second).toBe(worklet);
+  });
+
+  it("doesn't merge closures of the same code", () => {
+    const makeWorklet = (captured: number) => () => {
+      'worklet';
+      return captured;
+    };
+    runOnRuntime(workletRuntime, makeWorklet(1))();
+    runOnRuntime(workletRuntime, makeWorklet(2))();
+    const [first, second] = getMergeTargets();
+    expect(first).toEqual(expect.any(Function));
+    expect(second).toEqual(expect.any(Function));
+    expect(second).not.toBe(first);
+  });
+});
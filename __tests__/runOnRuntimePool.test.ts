@@ -0,0 +1,46 @@
+import type { WorkletRuntimePool } from '../src';
+import { parallelForOnRuntimePool, runOnRuntimePool } from '../src';
+
+describe('worklet runtime pool', () => {
+  const schedule = jest.fn();
+  const parallelFor = jest.fn();
+  const pool = { schedule, parallelFor } as unknown as WorkletRuntimePool;
+
+  afterEach(() => {
+    jest.clearAllMocks();
+  });
+
+  it('schedules the worklet with its arguments', () => {
+    const worklet = jest.fn();
+    const workletWrapper = (value: number) => {
+      'worklet';
+      worklet(value);
+    };
+    runOnRuntimePool(pool, workletWrapper)(42);
+    expect(schedule).toHaveBeenCalledTimes(1);
+    const [scheduled] = schedule.mock.calls[0];
+    scheduled();
+    expect(worklet).toHaveBeenCalledWith(42);
+  });
+
+  it('passes the count, the worklet and the completion callback', () => {
+    const worklet = (index: number) => {
+      'worklet';
+      return index;
+    };
+    const onComplete = jest.fn();
+    parallelForOnRuntimePool(pool, 8, worklet, onComplete);
+    expect(parallelFor).toHaveBeenCalledTimes(1);
+    const [count, shareable, callback] = parallelFor.mock.calls[0];
+    expect(count).toBe(8);
+    expect(shareable(3)).toBe(3);
+    expect(callback).toBe(onComplete);
+  });
+
+  it('throws when the function is not a worklet', () => {
+    expect(() =>
+      parallelForOnRuntimePool(pool, 1, (index: number) => index)
+    ).toThrow('is not a worklet');
+    expect(parallelFor).not.toHaveBeenCalled();
+  });
+});
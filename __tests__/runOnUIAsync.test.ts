@@ -0,0 +1,43 @@
+import type { WorkletRuntime } from '../src';
+import { runOnRuntimeAsync, runOnUIAsync } from '../src';
+
+describe('runOnUIAsync', () => {
+  it('resolves with the value returned by the worklet', async () => {
+    const add = (a: number, b: number) => {
+      'worklet';
+      return a + b;
+    };
+    await expect(runOnUIAsync(add)(1, 2)).resolves.toBe(3);
+  });
+
+  it('rejects with the error thrown by the worklet', async () => {
+    const fail = () => {
+      'worklet';
+      throw new Error('worklet failed');
+    };
+    await expect(runOnUIAsync(fail)()).rejects.toThrow('worklet failed');
+  });
+
+  it('runs the worklet after the current task', async () => {
+    const callback = jest.fn();
+    const promise = runOnUIAsync(() => {
+      'worklet';
+      callback();
+    })();
+    expect(callback).not.toBeCalled();
+    await promise;
+    expect(callback).toBeCalledTimes(1);
+  });
+});
+
+describe('runOnRuntimeAsync', () => {
+  it('is not available without worklet runtimes', () => {
+    const worklet = () => {
+      'worklet';
+      return 1;
+    };
+    expect(() => runOnRuntimeAsync({} as WorkletRuntime, worklet)()).toThrow(
+      'runOnRuntimeAsync is not available in JSReanimated'
+    );
+  });
+});
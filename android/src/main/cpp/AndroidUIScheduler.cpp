@@ -21,15 +21,12 @@ class UISchedulerWrapper : public UIScheduler {
       jni::global_ref<AndroidUIScheduler::javaobject> androidUiScheduler)
       : androidUiScheduler_(androidUiScheduler) {}
 
-  void scheduleOnUI(std::function<void()> job) override {
-    UIScheduler::scheduleOnUI(job);
-    if (!scheduledOnUI_) {
-      scheduledOnUI_ = true;
-      androidUiScheduler_->cthis()->scheduleTriggerOnUI();
-    }
-  }
-
   ~UISchedulerWrapper() {}
+
+ protected:
+  void requestTriggerUI() override {
+    androidUiScheduler_->cthis()->scheduleTriggerOnUI();
+  }
 };
 
 AndroidUIScheduler::AndroidUIScheduler(
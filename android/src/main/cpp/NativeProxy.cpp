@@ -11,11 +11,14 @@
 
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "AndroidUIScheduler.h"
 #include "LayoutAnimationsManager.h"
 #include "NativeProxy.h"
 #include "PlatformDepMethodsHolder.h"
+#include "PrecompiledWorkletBundle.h"
 #include "RNRuntimeDecorator.h"
 #include "ReanimatedJSIUtils.h"
 #include "ReanimatedRuntime.h"
@@ -89,6 +92,14 @@ jni::local_ref<NativeProxy::jhybriddata> NativeProxy::initHybrid(
         fabricUIManager,
 #endif
     const std::string &valueUnpackerCode) {
+  // The UI runtime loads the bundle, so its path has to be set before the
+  // module starts creating the runtime.
+  static const auto getPrecompiledWorkletBundlePath =
+      jThis->getClass()->getMethod<jstring()>(
+          "getPrecompiledWorkletBundlePath");
+  if (auto path = getPrecompiledWorkletBundlePath(jThis)) {
+    PrecompiledWorkletBundle::setPath(path->toStdString());
+  }
   auto jsCallInvoker = jsCallInvokerHolder->cthis()->getCallInvoker();
   auto uiScheduler = androidUiScheduler->cthis()->getUIScheduler();
   return makeCxxInstance(
@@ -405,6 +416,11 @@ void NativeProxy::handleEvent(
     return;
   }
 
+  if (!nativeReanimatedModule_->isUIRuntimeReady()) {
+    // there are no event handlers before the UI runtime is ready
+    return;
+  }
+  auto uiRuntimeLock = nativeReanimatedModule_->lockUIRuntime();
   jsi::Runtime &rt = nativeReanimatedModule_->getUIRuntime();
   jsi::Value payload;
   try {
@@ -507,13 +523,30 @@ void NativeProxy::setupLayoutAnimations() {
   layoutAnimations_->cthis()->setAnimationStartingBlock(
       [weakNativeReanimatedModule](
           int tag, int type, alias_ref<JMap<jstring, jstring>> values) {
-        if (auto nativeReanimatedModule = weakNativeReanimatedModule.lock()) {
+        auto nativeReanimatedModule = weakNativeReanimatedModule.lock();
+        if (nativeReanimatedModule == nullptr) {
+          return;
+        }
+        // `values` is only valid during this call, so the entries are copied
+        // in case the animation has to wait for the UI runtime.
+        std::vector<std::pair<std::string, std::string>> entries;
+        for (const auto &entry : *values) {
+          entries.emplace_back(
+              entry.first->toStdString(), entry.second->toStdString());
+        }
+        auto startLayoutAnimation = [weakNativeReanimatedModule,
+                                     tag,
+                                     type,
+                                     entries = std::move(entries)]() {
+          auto nativeReanimatedModule = weakNativeReanimatedModule.lock();
+          if (nativeReanimatedModule == nullptr) {
+            return;
+          }
+          auto uiRuntimeLock = nativeReanimatedModule->lockUIRuntime();
           jsi::Runtime &rt = nativeReanimatedModule->getUIRuntime();
           jsi::Object yogaValues(rt);
-          for (const auto &entry : *values) {
+          for (const auto &[keyString, valueString] : entries) {
             try {
-              std::string keyString = entry.first->toStdString();
-              std::string valueString = entry.second->toStdString();
               auto key = jsi::String::createFromAscii(rt, keyString);
               if (keyString == "currentTransformMatrix" ||
                   keyString == "targetTransformMatrix") {
@@ -532,11 +565,21 @@ void NativeProxy::setupLayoutAnimations() {
           nativeReanimatedModule->layoutAnimationsManager()
               .startLayoutAnimation(
                   rt, tag, static_cast<LayoutAnimationType>(type), yogaValues);
+        };
+        if (nativeReanimatedModule->isUIRuntimeReady()) {
+          startLayoutAnimation();
+        } else {
+          // The view has already been told it has an animation, so instead of
+          // dropping it we start it once the UI runtime is ready.
+          nativeReanimatedModule->scheduleOnUIRuntime(
+              std::move(startLayoutAnimation));
         }
       });
 
   layoutAnimations_->cthis()->setHasAnimationBlock(
       [weakNativeReanimatedModule](int tag, int type) {
+        // Only reads the configs, so it doesn't need the UI runtime to be
+        // ready.
         if (auto nativeReanimatedModule = weakNativeReanimatedModule.lock()) {
           return nativeReanimatedModule->layoutAnimationsManager()
               .hasLayoutAnimation(tag, static_cast<LayoutAnimationType>(type));
@@ -573,7 +616,10 @@ void NativeProxy::setupLayoutAnimations() {
 
   layoutAnimations_->cthis()->setCancelAnimationForTag(
       [weakNativeReanimatedModule](int tag) {
-        if (auto nativeReanimatedModule = weakNativeReanimatedModule.lock()) {
+        auto nativeReanimatedModule = weakNativeReanimatedModule.lock();
+        if (nativeReanimatedModule != nullptr &&
+            nativeReanimatedModule->isUIRuntimeReady()) {
+          auto uiRuntimeLock = nativeReanimatedModule->lockUIRuntime();
           jsi::Runtime &rt = nativeReanimatedModule->getUIRuntime();
           nativeReanimatedModule->layoutAnimationsManager()
               .cancelLayoutAnimation(rt, tag);
@@ -1,6 +1,8 @@
 package com.swmansion.reanimated.nativeProxy;
 
 import android.content.ContentResolver;
+import android.content.Context;
+import android.content.pm.PackageManager;
 import android.os.SystemClock;
 import android.provider.Settings;
 import android.util.Log;
@@ -26,6 +28,12 @@ import com.swmansion.reanimated.layoutReanimation.AnimationsManager;
 import com.swmansion.reanimated.layoutReanimation.LayoutAnimations;
 import com.swmansion.reanimated.sensor.ReanimatedSensorContainer;
 import com.swmansion.reanimated.sensor.ReanimatedSensorType;
+import java.io.File;
+import java.io.FileNotFoundException;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.io.InputStream;
+import java.io.OutputStream;
 import java.lang.ref.WeakReference;
 import java.util.ArrayList;
 import java.util.HashSet;
@@ -246,6 +254,48 @@ public abstract class NativeProxyCommon {
     animationsManager.setNativeMethods(NativeProxy.createNativeMethodsHolder(layoutAnimations));
   }
 
+  private static final String PRECOMPILED_WORKLET_BUNDLE_NAME = "worklets.hbc";
+
+  /**
+   * Apps opt in to precompiled worklets by shipping `worklets.hbc` as an asset, see
+   * `scripts/build-worklet-bundle.js`. Assets can't be memory-mapped from the APK, so the bundle is
+   * copied to the files dir, once per app update.
+   */
+  @DoNotStrip
+  public String getPrecompiledWorkletBundlePath() {
+    Context context = mContext.get();
+    if (context == null) {
+      return null;
+    }
+    File file = new File(context.getFilesDir(), PRECOMPILED_WORKLET_BUNDLE_NAME);
+    try (InputStream input = context.getAssets().open(PRECOMPILED_WORKLET_BUNDLE_NAME)) {
+      long lastUpdateTime =
+          context.getPackageManager().getPackageInfo(context.getPackageName(), 0).lastUpdateTime;
+      if (file.exists() && file.lastModified() >= lastUpdateTime) {
+        return file.getAbsolutePath();
+      }
+      // the file is renamed only once it's complete in case the app gets killed
+      File tempFile = new File(file.getAbsolutePath() + ".tmp");
+      try (OutputStream output = new FileOutputStream(tempFile)) {
+        byte[] buffer = new byte[64 * 1024];
+        int read;
+        while ((read = input.read(buffer)) != -1) {
+          output.write(buffer, 0, read);
+        }
+      }
+      if (!tempFile.renameTo(file)) {
+        throw new IOException("Failed to rename " + tempFile);
+      }
+      return file.getAbsolutePath();
+    } catch (FileNotFoundException e) {
+      // the app doesn't ship the bundle
+      return null;
+    } catch (IOException | PackageManager.NameNotFoundException e) {
+      Log.w("[REANIMATED]", "Failed to copy the precompiled worklet bundle", e);
+      return null;
+    }
+  }
+
   @DoNotStrip
   public boolean getIsReducedMotion() {
     ContentResolver mContentResolver = mContext.get().getContentResolver();
@@ -17,6 +17,7 @@
 #endif
 
 #import <RNReanimated/NativeProxy.h>
+#import <RNReanimated/PrecompiledWorkletBundle.h>
 #import <RNReanimated/REAModule.h>
 #import <RNReanimated/REANodesManager.h>
 #import <RNReanimated/REAUIKit.h>
@@ -264,6 +265,13 @@ RCT_EXPORT_BLOCKING_SYNCHRONOUS_METHOD(installTurboModule : (nonnull NSString *)
       : nullptr;
 
   if (jsiRuntime) {
+    // Apps opt in to precompiled worklets by shipping the bundle built by
+    // `scripts/build-worklet-bundle.js` as a resource.
+    NSString *workletBundlePath = [[NSBundle mainBundle] pathForResource:@"worklets" ofType:@"hbc"];
+    if (workletBundlePath != nil) {
+      PrecompiledWorkletBundle::setPath(std::string([workletBundlePath UTF8String]));
+    }
+
     auto nativeReanimatedModule = reanimated::createReanimatedModule(
         self.bridge, self.bridge.jsCallInvoker, std::string([valueUnpackerCode UTF8String]));
 
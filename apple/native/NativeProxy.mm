@@ -293,9 +293,14 @@ std::shared_ptr<NativeReanimatedModule> createReanimatedModule(
 
   [reaModule.nodesManager registerEventHandler:^(id<RCTEvent> event) {
     // handles RCTEvents from RNGestureHandler
+    if (!nativeReanimatedModule->isUIRuntimeReady()) {
+      // there are no event handlers before the UI runtime is ready
+      return;
+    }
     std::string eventName = [event.eventName UTF8String];
     int emitterReactTag = [event.viewTag intValue];
     id eventData = [event arguments][2];
+    auto uiRuntimeLock = nativeReanimatedModule->lockUIRuntime();
     jsi::Runtime &uiRuntime = nativeReanimatedModule->getUIRuntime();
     jsi::Value payload = convertObjCObjectToJSIValue(uiRuntime, eventData);
     double currentTime = CACurrentMediaTime() * 1000;
@@ -313,7 +318,16 @@ std::shared_ptr<NativeReanimatedModule> createReanimatedModule(
   // Layout Animation callbacks setup
   [animationsManager
       setAnimationStartingBlock:^(NSNumber *_Nonnull tag, LayoutAnimationType type, NSDictionary *_Nonnull values) {
-        if (auto nativeReanimatedModule = weakNativeReanimatedModule.lock()) {
+        auto nativeReanimatedModule = weakNativeReanimatedModule.lock();
+        if (nativeReanimatedModule == nullptr) {
+          return;
+        }
+        auto startLayoutAnimation = [weakNativeReanimatedModule, viewTag = [tag intValue], type, values]() {
+          auto nativeReanimatedModule = weakNativeReanimatedModule.lock();
+          if (nativeReanimatedModule == nullptr) {
+            return;
+          }
+          auto uiRuntimeLock = nativeReanimatedModule->lockUIRuntime();
           jsi::Runtime &rt = nativeReanimatedModule->getUIRuntime();
           jsi::Object yogaValues(rt);
           for (NSString *key in values.allKeys) {
@@ -329,11 +343,19 @@ std::shared_ptr<NativeReanimatedModule> createReanimatedModule(
               yogaValues.setProperty(rt, [key UTF8String], [(NSNumber *)value doubleValue]);
             }
           }
-          nativeReanimatedModule->layoutAnimationsManager().startLayoutAnimation(rt, [tag intValue], type, yogaValues);
+          nativeReanimatedModule->layoutAnimationsManager().startLayoutAnimation(rt, viewTag, type, yogaValues);
+        };
+        if (nativeReanimatedModule->isUIRuntimeReady()) {
+          startLayoutAnimation();
+        } else {
+          // The view has already been told it has an animation, so instead of
+          // dropping it we start it once the UI runtime is ready.
+          nativeReanimatedModule->scheduleOnUIRuntime(std::move(startLayoutAnimation));
         }
       }];
 
   [animationsManager setHasAnimationBlock:^(NSNumber *_Nonnull tag, LayoutAnimationType type) {
+    // Only reads the configs, so it doesn't need the UI runtime to be ready.
     if (auto nativeReanimatedModule = weakNativeReanimatedModule.lock()) {
       bool hasLayoutAnimation =
           nativeReanimatedModule->layoutAnimationsManager().hasLayoutAnimation([tag intValue], type);
@@ -358,7 +380,9 @@ std::shared_ptr<NativeReanimatedModule> createReanimatedModule(
   }];
 
   [animationsManager setCancelAnimationBlock:^(NSNumber *_Nonnull tag) {
-    if (auto nativeReanimatedModule = weakNativeReanimatedModule.lock()) {
+    auto nativeReanimatedModule = weakNativeReanimatedModule.lock();
+    if (nativeReanimatedModule != nullptr && nativeReanimatedModule->isUIRuntimeReady()) {
+      auto uiRuntimeLock = nativeReanimatedModule->lockUIRuntime();
       jsi::Runtime &rt = nativeReanimatedModule->getUIRuntime();
       nativeReanimatedModule->layoutAnimationsManager().cancelLayoutAnimation(rt, [tag intValue]);
     }
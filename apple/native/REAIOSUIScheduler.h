@@ -11,7 +11,10 @@ using namespace react;
 
 class REAIOSUIScheduler : public UIScheduler {
  public:
-  void scheduleOnUI(std::function<void()> job) override;
+  void scheduleOnUI(UIJob job, UILane lane) override;
+
+ protected:
+  void requestTriggerUI() override;
 };
 
 } // namespace reanimated
@@ -1,24 +1,27 @@
 #import <RNReanimated/REAIOSUIScheduler.h>
 
+#include <utility>
+
 namespace reanimated {
 
 using namespace facebook;
 using namespace react;
 
-void REAIOSUIScheduler::scheduleOnUI(std::function<void()> job)
+void REAIOSUIScheduler::scheduleOnUI(UIJob job, UILane lane)
 {
-  if ([NSThread isMainThread]) {
+  if (lane == UILane::Urgent && [NSThread isMainThread]) {
     job();
     return;
   }
 
-  UIScheduler::scheduleOnUI(job);
+  UIScheduler::scheduleOnUI(std::move(job), lane);
+}
 
-  if (!scheduledOnUI_) {
-    dispatch_async(dispatch_get_main_queue(), ^{
-      triggerUI();
-    });
-  }
+void REAIOSUIScheduler::requestTriggerUI()
+{
+  dispatch_async(dispatch_get_main_queue(), ^{
+    triggerUI();
+  });
 }
 
 } // namespace reanimated
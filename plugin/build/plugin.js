@@ -283,7 +283,7 @@ var require_globals = __commonJS({
       "_setGestureState",
       "_notifyAboutProgress",
       "_notifyAboutEnd",
-      "_runOnUIQueue",
+      "_runOnUIQueues",
       "_getAnimationTimestamp"
     ]);
     function initializeGlobals() {
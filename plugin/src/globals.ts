@@ -131,7 +131,7 @@ export const defaultGlobals = new Set([
   '_setGestureState',
   '_notifyAboutProgress',
   '_notifyAboutEnd',
-  '_runOnUIQueue',
+  '_runOnUIQueues',
   '_getAnimationTimestamp',
 ]);
 
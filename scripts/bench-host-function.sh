@@ -0,0 +1,19 @@
+#!/bin/bash
+
+# Benchmarks the dispatch of JSI host functions created by
+# `jsi_utils::createHostFunction` against the previous implementation. It's
+# built against a mock of JSI, see `scripts/bench-host-function/jsi/jsi.h`, so
+# that it runs on the host without React Native.
+
+set -e
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+OUT=$(mktemp -d)
+trap 'rm -rf "$OUT"' EXIT
+
+${CXX:-c++} -O2 -std=c++17 -DNDEBUG \
+  -I "$ROOT/scripts/bench-host-function" \
+  -I "$ROOT/Common/cpp/Tools" \
+  "$ROOT/scripts/bench-host-function/bench.cpp" \
+  -o "$OUT/bench-host-function"
+"$OUT/bench-host-function"
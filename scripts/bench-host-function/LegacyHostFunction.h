@@ -0,0 +1,91 @@
+#pragma once
+
+// `createHostFunction` as it was before arguments were converted in place,
+// kept as the baseline of the benchmark. It wraps every callable in
+// a `std::function` and converts the arguments into a tuple through
+// a chain of recursive helpers.
+
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "ReanimatedJSIUtils.h"
+
+namespace reanimated {
+namespace legacy_jsi_utils {
+
+using jsi_utils::get;
+
+template <typename... Args>
+inline std::enable_if_t<(sizeof...(Args) == 0), std::tuple<>> convertArgs(
+    jsi::Runtime &,
+    const jsi::Value *) {
+  return std::make_tuple();
+}
+
+template <typename T, typename... Rest>
+inline std::tuple<T, Rest...> convertArgs(
+    jsi::Runtime &rt,
+    const jsi::Value *args) {
+  auto arg = std::tuple<T>(get<T>(rt, args));
+  auto rest = convertArgs<Rest...>(rt, std::next(args));
+  return std::tuple_cat(std::move(arg), std::move(rest));
+}
+
+template <typename Ret, typename... Args>
+std::tuple<Args...> getArgsForFunction(
+    std::function<Ret(Args...)>,
+    jsi::Runtime &rt,
+    const jsi::Value *args,
+    const size_t count) {
+  assert(sizeof...(Args) == count);
+  return convertArgs<Args...>(rt, args);
+}
+
+template <typename Ret, typename... Args>
+std::tuple<jsi::Runtime &, Args...> getArgsForFunction(
+    std::function<Ret(jsi::Runtime &, Args...)>,
+    jsi::Runtime &rt,
+    const jsi::Value *args,
+    const size_t count) {
+  assert(sizeof...(Args) == count);
+  return std::tuple_cat(std::tie(rt), convertArgs<Args...>(rt, args));
+}
+
+template <typename Ret, typename... Args>
+inline jsi::Value apply(
+    std::function<Ret(Args...)> function,
+    std::tuple<Args...> args) {
+  return std::apply(function, std::move(args));
+}
+
+template <typename... Args>
+inline jsi::Value apply(
+    std::function<void(Args...)> function,
+    std::tuple<Args...> args) {
+  std::apply(function, std::move(args));
+  return jsi::Value::undefined();
+}
+
+template <typename Ret, typename... Args>
+jsi::HostFunctionType createHostFunction(
+    std::function<Ret(Args...)> function) {
+  return [function](
+             jsi::Runtime &rt,
+             const jsi::Value &,
+             const jsi::Value *args,
+             const size_t count) {
+    auto argz = getArgsForFunction(function, rt, args, count);
+    return apply(function, std::move(argz));
+  };
+}
+
+// the old `installJsiFunction` converted every callable to `std::function`
+template <typename Fun>
+jsi::HostFunctionType createHostFunction(Fun function) {
+  return createHostFunction(std::function(std::move(function)));
+}
+
+} // namespace legacy_jsi_utils
+} // namespace reanimated
@@ -0,0 +1,64 @@
+// Compares the dispatch cost of host functions created by
+// `jsi_utils::createHostFunction` with the previous implementation, see
+// `LegacyHostFunction.h`. Run `scripts/bench-host-function.sh`.
+
+#include <chrono>
+#include <cstdio>
+#include <functional>
+
+#include "LegacyHostFunction.h"
+#include "ReanimatedJSIUtils.h"
+
+using namespace reanimated;
+
+static constexpr int kCalls = 50'000'000;
+static constexpr int kRounds = 3;
+
+static volatile double sink;
+
+template <typename Call>
+static void measure(const char *name, Call &&call) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kCalls; i++) {
+    call(i);
+  }
+  auto end = std::chrono::steady_clock::now();
+  auto nanoseconds = std::chrono::duration<double, std::nano>(end - start);
+  std::printf("%-36s %6.2f ns/call\n", name, nanoseconds.count() / kCalls);
+}
+
+int main() {
+  jsi::Runtime rt;
+  jsi::Value thisValue;
+  jsi::Value args[3] = {jsi::Value(1.0), jsi::Value(2.0), jsi::Value(true)};
+
+  auto lambda = [](jsi::Runtime &, int a, double b, bool c) -> double {
+    return a + b + c;
+  };
+  std::function<void(int, int)> function = [](int a, int b) { sink = a + b; };
+
+  auto legacyLambda = legacy_jsi_utils::createHostFunction(lambda);
+  auto currentLambda = jsi_utils::createHostFunction(lambda);
+  auto legacyFunction = legacy_jsi_utils::createHostFunction(function);
+  auto currentFunction = jsi_utils::createHostFunction(function);
+
+  for (int round = 0; round < kRounds; round++) {
+    measure("legacy lambda(rt, int, double, bool)", [&](int i) {
+      args[0] = jsi::Value(i);
+      sink = legacyLambda(rt, thisValue, args, 3).asNumber();
+    });
+    measure("current lambda(rt, int, double, bool)", [&](int i) {
+      args[0] = jsi::Value(i);
+      sink = currentLambda(rt, thisValue, args, 3).asNumber();
+    });
+    measure("legacy std::function(int, int)", [&](int i) {
+      args[0] = jsi::Value(i);
+      legacyFunction(rt, thisValue, args, 2);
+    });
+    measure("current std::function(int, int)", [&](int i) {
+      args[0] = jsi::Value(i);
+      currentFunction(rt, thisValue, args, 2);
+    });
+  }
+  return 0;
+}
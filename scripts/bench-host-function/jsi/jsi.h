@@ -0,0 +1,111 @@
+#pragma once
+
+// A minimal stand-in for JSI, just enough to compile `ReanimatedJSIUtils.h`.
+// Values only hold numbers and booleans and the runtime does nothing, so the
+// benchmark measures argument conversion and dispatch only.
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <string>
+
+namespace facebook {
+namespace jsi {
+
+class Runtime;
+class Value;
+
+class JSINativeException : public std::runtime_error {
+ public:
+  using std::runtime_error::runtime_error;
+};
+
+using HostFunctionType =
+    std::function<Value(Runtime &, const Value &, const Value *, size_t)>;
+
+class Object {
+ public:
+  explicit Object(Runtime &) {}
+
+  template <typename T>
+  void setProperty(Runtime &, const char *, T &&) {}
+};
+
+class Array : public Object {
+ public:
+  Array(Runtime &rt, size_t) : Object(rt) {}
+};
+
+class PropNameID {
+ public:
+  static PropNameID forAscii(Runtime &, const char *) {
+    return PropNameID();
+  }
+};
+
+class Function : public Object {
+ public:
+  static Function createFromHostFunction(
+      Runtime &rt,
+      const PropNameID &,
+      unsigned int,
+      HostFunctionType) {
+    return Function(rt);
+  }
+
+ private:
+  using Object::Object;
+};
+
+class Value {
+ public:
+  Value() = default;
+  Value(double number) : kind_(Kind::Number), number_(number) {}
+  Value(int number) : Value(static_cast<double>(number)) {}
+  Value(bool boolean) : kind_(Kind::Boolean), number_(boolean) {}
+  Value(Object &&) : kind_(Kind::Object) {}
+
+  static Value undefined() {
+    return Value();
+  }
+
+  bool isBool() const {
+    return kind_ == Kind::Boolean;
+  }
+
+  bool getBool() const {
+    return number_ != 0;
+  }
+
+  double asNumber() const {
+    if (kind_ != Kind::Number) {
+      throw JSINativeException("Value is not a number.");
+    }
+    return number_;
+  }
+
+  Object asObject(Runtime &rt) const;
+
+ private:
+  enum class Kind { Undefined, Number, Boolean, Object };
+  Kind kind_ = Kind::Undefined;
+  double number_ = 0;
+};
+
+class Runtime {
+ public:
+  Object global() {
+    return Object(*this);
+  }
+};
+
+inline Object Value::asObject(Runtime &rt) const {
+  if (kind_ != Kind::Object) {
+    throw JSINativeException("Value is not an object.");
+  }
+  return Object(rt);
+}
+
+} // namespace jsi
+} // namespace facebook
@@ -0,0 +1,181 @@
+/**
+ * Builds the precompiled worklet bundle of an app, which lets the worklet
+ * runtimes skip parsing the code of worklets at runtime. See
+ * `Common/cpp/ReanimatedRuntime/PrecompiledWorkletBundle.h` for the contract
+ * of the bundle.
+ *
+ * The worklets are extracted from a release JS bundle of the app, i.e. one
+ * built with `--dev false` by `react-native bundle`, and compiled to Hermes
+ * bytecode with `hermesc`:
+ *
+ *   node node_modules/react-native-reanimated/scripts/build-worklet-bundle.js \
+ *     --bundle index.android.bundle --out worklets.hbc [--hermesc <path>]
+ *
+ * The resulting `worklets.hbc` has to be rebuilt together with the JS bundle
+ * and shipped as a resource of the main bundle on iOS or as an asset on
+ * Android (e.g. in `android/app/src/main/assets`). Worklets whose code doesn't
+ * match the JS bundle are never used, so a stale file only costs memory.
+ */
+const fs = require('fs');
+const path = require('path');
+const { execFileSync } = require('child_process');
+const { parseSync, traverse } = require('@babel/core');
+
+function parseArgs(argv) {
+  const args = {};
+  for (let i = 0; i < argv.length; i++) {
+    const arg = argv[i];
+    if (arg === '--help' || arg === '-h') {
+      args.help = true;
+    } else if (arg.startsWith('--')) {
+      args[arg.substring(2)] = argv[++i];
+    }
+  }
+  return args;
+}
+
+// Must be kept in sync with `hash` in `plugin/src/makeWorklet.ts`, the
+// worklets are looked up by the hash of their code.
+function hash(str) {
+  let i = str.length;
+  let hash1 = 5381;
+  let hash2 = 52711;
+  while (i--) {
+    const char = str.charCodeAt(i);
+    // eslint-disable-next-line no-bitwise
+    hash1 = (hash1 * 33) ^ char;
+    // eslint-disable-next-line no-bitwise
+    hash2 = (hash2 * 33) ^ char;
+  }
+  // eslint-disable-next-line no-bitwise
+  return (hash1 >>> 0) * 4096 + (hash2 >>> 0);
+}
+
+function isNamed(node, name) {
+  return (
+    (node.type === 'Identifier' && node.name === name) ||
+    (node.type === 'StringLiteral' && node.value === name)
+  );
+}
+
+// The plugin assigns `{ code: '...' }` to `__initData` of every worklet, either
+// directly or through a variable, depending on how the bundle was minified.
+function getWorkletCode(initDataPath) {
+  let initData = initDataPath.node;
+  if (initData.type === 'Identifier') {
+    const binding = initDataPath.scope.getBinding(initData.name);
+    if (!binding || !binding.path.isVariableDeclarator()) {
+      return undefined;
+    }
+    initData = binding.path.node.init;
+  }
+  if (!initData || initData.type !== 'ObjectExpression') {
+    return undefined;
+  }
+  const code = initData.properties.find(
+    (property) =>
+      property.type === 'ObjectProperty' &&
+      !property.computed &&
+      isNamed(property.key, 'code')
+  );
+  return code && code.value.type === 'StringLiteral'
+    ? code.value.value
+    : undefined;
+}
+
+function extractWorklets(bundleCode) {
+  const ast = parseSync(bundleCode, {
+    babelrc: false,
+    configFile: false,
+    sourceType: 'script',
+  });
+  const worklets = new Map();
+  traverse(ast, {
+    AssignmentExpression(assignment) {
+      const left = assignment.node.left;
+      if (
+        left.type !== 'MemberExpression' ||
+        !isNamed(left.property, '__initData')
+      ) {
+        return;
+      }
+      const code = getWorkletCode(assignment.get('right'));
+      if (code !== undefined) {
+        worklets.set(hash(code), code);
+      }
+    },
+  });
+  return worklets;
+}
+
+// Mirrors the initialization of the caches in `valueUnpacker`.
+function makeWorkletBundle(worklets) {
+  const entries = [...worklets].map(
+    ([workletHash, code]) => `  cache.set(${workletHash}, (${code}\n));`
+  );
+  return `(function () {
+  var cache = global.__workletsCache;
+  if (cache === undefined) {
+    cache = global.__workletsCache = new Map();
+    global.__handleCache = new WeakMap();
+  }
+${entries.join('\n')}
+})();
+`;
+}
+
+function findHermesc() {
+  const binDir = {
+    darwin: 'osx-bin',
+    linux: 'linux64-bin',
+    win32: 'win64-bin',
+  }[process.platform];
+  try {
+    const reactNativeDir = path.dirname(
+      require.resolve('react-native/package.json', { paths: [process.cwd()] })
+    );
+    const hermesc = path.join(reactNativeDir, 'sdks', 'hermesc', binDir);
+    return fs.existsSync(hermesc)
+      ? path.join(hermesc, 'hermesc')
+      : undefined;
+  } catch (e) {
+    return undefined;
+  }
+}
+
+function main() {
+  const args = parseArgs(process.argv.slice(2));
+  if (args.help || !args.bundle || !args.out) {
+    console.warn(
+      'Usage: build-worklet-bundle.js --bundle <release JS bundle> --out <worklets.hbc> [--hermesc <path to hermesc>]'
+    );
+    process.exitCode = 1;
+    return;
+  }
+
+  const worklets = extractWorklets(fs.readFileSync(args.bundle, 'utf8'));
+  if (worklets.size === 0) {
+    throw new Error(
+      `[Reanimated] No worklets found in ${args.bundle}, make sure it's a release bundle built with the Reanimated Babel plugin.`
+    );
+  }
+
+  const hermesc = args.hermesc || findHermesc();
+  if (hermesc === undefined) {
+    throw new Error(
+      '[Reanimated] hermesc not found, pass its path with --hermesc.'
+    );
+  }
+  const source = `${args.out}.js`;
+  fs.writeFileSync(source, makeWorkletBundle(worklets));
+  try {
+    execFileSync(hermesc, ['-emit-binary', '-O', '-out', args.out, source], {
+      stdio: 'inherit',
+    });
+  } finally {
+    fs.unlinkSync(source);
+  }
+  console.log(`Precompiled ${worklets.size} worklets to ${args.out}.`);
+}
+
+main();
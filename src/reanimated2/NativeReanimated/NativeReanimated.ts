@@ -1,13 +1,26 @@
 'use strict';
 import { NativeModules } from 'react-native';
-import type { ShareableRef, Value3D, ValueRotation } from '../commonTypes';
+import type {
+  ArrayBufferTransferMode,
+  ExecuteOnUIRuntimeSyncOptions,
+  ShareableRef,
+  UILane,
+  Value3D,
+  ValueRotation,
+} from '../commonTypes';
 import type {
   LayoutAnimationFunction,
   LayoutAnimationType,
 } from '../layoutReanimation';
 import { checkCppVersion } from '../platform-specific/checkCppVersion';
 import { jsVersion } from '../platform-specific/jsVersion';
-import type { WorkletRuntime } from '../runtimes';
+import type {
+  FrameBudgetStats,
+  RuntimeLockStats,
+  WorkletRuntime,
+  WorkletRuntimeConfig,
+  WorkletRuntimePool,
+} from '../runtimes';
 import { getValueUnpackerCode } from '../valueUnpacker';
 import type { LayoutAnimationBatchItem } from '../layoutReanimation/animationBuilder/commonTypes';
 
@@ -15,18 +28,38 @@ import type { LayoutAnimationBatchItem } from '../layoutReanimation/animationBui
 export interface NativeReanimatedModule {
   makeShareableClone<T>(
     value: T,
-    shouldPersistRemote: boolean
+    shouldPersistRemote: boolean,
+    arrayBufferTransferMode?: ArrayBufferTransferMode,
+    isTypedArray?: boolean,
+    isPlainData?: boolean
   ): ShareableRef<T>;
-  scheduleOnUI<T>(shareable: ShareableRef<T>): void;
-  executeOnUIRuntimeSync<T, R>(shareable: ShareableRef<T>): R;
+  enableShareableDeduplication(flag: boolean): void;
+  scheduleOnUI<T>(shareable: ShareableRef<T>, lane?: UILane): void;
+  executeOnUIRuntimeSync<T, R>(
+    shareable: ShareableRef<T>,
+    options?: ExecuteOnUIRuntimeSyncOptions
+  ): R;
+  getUIRuntimeLockStats(): RuntimeLockStats;
+  getFrameBudgetStats(): FrameBudgetStats;
   createWorkletRuntime(
     name: string,
-    initializer: ShareableRef<() => void>
+    initializer: ShareableRef<() => void>,
+    config?: WorkletRuntimeConfig
   ): WorkletRuntime;
+  createWorkletRuntimePool(
+    name: string,
+    size: number | undefined,
+    initializer: ShareableRef<() => void>
+  ): WorkletRuntimePool;
   scheduleOnRuntime<T>(
     workletRuntime: WorkletRuntime,
-    worklet: ShareableRef<T>
+    worklet: ShareableRef<T>,
+    mergeKey?: number
   ): void;
+  runOnRuntimeAsync<T, R>(
+    workletRuntime: WorkletRuntime | undefined,
+    worklet: ShareableRef<T>
+  ): Promise<R>;
   registerEventHandler<T>(
     eventHandler: ShareableRef<T>,
     eventName: string,
@@ -80,6 +113,21 @@ See \`https://docs.swmansion.com/react-native-reanimated/docs/guides/troubleshoo
   }
 }
 
+const mergeKeys = new WeakMap<object, number>();
+let nextMergeKey = 1;
+
+// Identifies the object, e.g. a worklet function rather than its code, since
+// closures of the same code may capture different values. Kept out of
+// `runOnRuntime` so that workletizing it doesn't capture the map.
+function getMergeKey(mergeWith: object): number {
+  let mergeKey = mergeKeys.get(mergeWith);
+  if (mergeKey === undefined) {
+    mergeKey = nextMergeKey++;
+    mergeKeys.set(mergeWith, mergeKey);
+  }
+  return mergeKey;
+}
+
 export class NativeReanimated {
   private InnerNativeModule: NativeReanimatedModule;
 
@@ -106,30 +154,88 @@ See https://docs.swmansion.com/react-native-reanimated/docs/guides/troubleshooti
     this.InnerNativeModule = global.__reanimatedModuleProxy;
   }
 
-  makeShareableClone<T>(value: T, shouldPersistRemote: boolean) {
+  makeShareableClone<T>(
+    value: T,
+    shouldPersistRemote: boolean,
+    arrayBufferTransferMode?: ArrayBufferTransferMode,
+    isTypedArray?: boolean,
+    isPlainData?: boolean
+  ) {
     return this.InnerNativeModule.makeShareableClone(
       value,
-      shouldPersistRemote
+      shouldPersistRemote,
+      arrayBufferTransferMode,
+      isTypedArray,
+      isPlainData
     );
   }
 
-  scheduleOnUI<T>(shareable: ShareableRef<T>) {
-    return this.InnerNativeModule.scheduleOnUI(shareable);
+  enableShareableDeduplication(flag: boolean) {
+    this.InnerNativeModule.enableShareableDeduplication(flag);
   }
 
-  executeOnUIRuntimeSync<T, R>(shareable: ShareableRef<T>): R {
-    return this.InnerNativeModule.executeOnUIRuntimeSync(shareable);
+  scheduleOnUI<T>(shareable: ShareableRef<T>, lane?: UILane) {
+    return this.InnerNativeModule.scheduleOnUI(shareable, lane);
   }
 
-  createWorkletRuntime(name: string, initializer: ShareableRef<() => void>) {
-    return this.InnerNativeModule.createWorkletRuntime(name, initializer);
+  executeOnUIRuntimeSync<T, R>(
+    shareable: ShareableRef<T>,
+    options?: ExecuteOnUIRuntimeSyncOptions
+  ): R {
+    return this.InnerNativeModule.executeOnUIRuntimeSync(shareable, options);
   }
 
+  getUIRuntimeLockStats(): RuntimeLockStats {
+    return this.InnerNativeModule.getUIRuntimeLockStats();
+  }
+
+  getFrameBudgetStats(): FrameBudgetStats {
+    return this.InnerNativeModule.getFrameBudgetStats();
+  }
+
+  createWorkletRuntime(
+    name: string,
+    initializer: ShareableRef<() => void>,
+    config?: WorkletRuntimeConfig
+  ) {
+    return this.InnerNativeModule.createWorkletRuntime(
+      name,
+      initializer,
+      config
+    );
+  }
+
+  createWorkletRuntimePool(
+    name: string,
+    size: number | undefined,
+    initializer: ShareableRef<() => void>
+  ) {
+    return this.InnerNativeModule.createWorkletRuntimePool(
+      name,
+      size,
+      initializer
+    );
+  }
+
+  // Calls scheduled with the same `mergeWith` object can be merged by the
+  // queue of the runtime.
   scheduleOnRuntime<T>(
     workletRuntime: WorkletRuntime,
-    shareableWorklet: ShareableRef<T>
+    shareableWorklet: ShareableRef<T>,
+    mergeWith?: object
   ) {
     return this.InnerNativeModule.scheduleOnRuntime(
+      workletRuntime,
+      shareableWorklet,
+      mergeWith === undefined ? undefined : getMergeKey(mergeWith)
+    );
+  }
+
+  runOnRuntimeAsync<T, R>(
+    workletRuntime: WorkletRuntime | undefined,
+    shareableWorklet: ShareableRef<T>
+  ): Promise<R> {
+    return this.InnerNativeModule.runOnRuntimeAsync(
       workletRuntime,
       shareableWorklet
     );
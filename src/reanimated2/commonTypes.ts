@@ -46,6 +46,37 @@ export type FlatShareableRef<T> = T extends ShareableRef<infer U>
   ? ShareableRef<U>
   : ShareableRef<T>;
 
+// Decides how the contents of an ArrayBuffer or a typed array are handed over
+// to other runtimes, see `makeShareableArrayBuffer`.
+export type ArrayBufferTransferMode = 'copy' | 'share' | 'transfer';
+
+// Work scheduled in the 'deferrable' lane runs on the UI thread only after all
+// 'urgent' work, when the UI thread has time to spare. Otherwise it yields to
+// the next turn of the UI loop, not to the next frame.
+export type UILane = 'urgent' | 'deferrable';
+
+export type RunOnUIOptions = {
+  lane?: UILane;
+};
+
+export type RunOnJSOptions = {
+  // When true, a call that is still waiting to be delivered to the JS thread
+  // is replaced by the next call of the same function, so that only the call
+  // with the latest arguments runs.
+  coalesce?: boolean;
+};
+
+export type ExecuteOnUIRuntimeSyncOptions = {
+  // How long to wait for the UI runtime in milliseconds, must be finite and
+  // non-negative, 0 only tries once.
+  // Without a timeout the call waits for as long as it takes.
+  timeout?: number;
+  // What to do when the UI runtime couldn't be locked in time: 'throw' an
+  // error (default), 'skip' the worklet, or run it asynchronously ('async').
+  // In the latter two cases the call returns `undefined`.
+  onTimeout?: 'throw' | 'skip' | 'async';
+};
+
 export type MapperRawInputs = unknown[];
 
 export type MapperOutputs = SharedValue[];
@@ -23,10 +23,37 @@ import type {
 import { SensorContainer } from './SensorContainer';
 
 export { startMapper, stopMapper } from './mappers';
-export { runOnJS, runOnUI, executeOnUIRuntimeSync } from './threads';
-export { createWorkletRuntime, runOnRuntime } from './runtimes';
-export type { WorkletRuntime } from './runtimes';
-export { makeShareable, makeShareableCloneRecursive } from './shareables';
+export {
+  runOnJS,
+  runOnUI,
+  runOnUIAsync,
+  executeOnUIRuntimeSync,
+  requestDeferrableAnimationFrame,
+} from './threads';
+export {
+  createWorkletRuntime,
+  runOnRuntime,
+  runOnRuntimeAsync,
+  getUIRuntimeLockStats,
+  getFrameBudgetStats,
+  createWorkletRuntimePool,
+  runOnRuntimePool,
+  parallelForOnRuntimePool,
+} from './runtimes';
+export type {
+  WorkletRuntime,
+  WorkletRuntimeConfig,
+  WorkletRuntimeQueueOverflowPolicy,
+  WorkletRuntimeQueueStats,
+  WorkletRuntimePool,
+  RuntimeLockStats,
+  FrameBudgetStats,
+} from './runtimes';
+export {
+  makeShareable,
+  makeShareableArrayBuffer,
+  makeShareableCloneRecursive,
+} from './shareables';
 export { makeMutable } from './mutables';
 
 const IS_FABRIC = isFabric();
@@ -194,6 +221,17 @@ export function enableLayoutAnimations(
   }
 }
 
+/**
+ * Lets identical plain-data objects and arrays (e.g. the same animation config
+ * passed from every row of a list) that are converted to shareables share a
+ * single native copy, and the very same JS object once they are unpacked on a
+ * worklet runtime. Only enable it if such values are never modified after
+ * they are passed to worklets.
+ */
+export function enableShareableDeduplication(flag: boolean): void {
+  NativeReanimatedModule.enableShareableDeduplication(flag);
+}
+
 export function configureLayoutAnimations(
   viewTag: number | HTMLElement,
   type: LayoutAnimationType,
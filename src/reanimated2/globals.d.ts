@@ -22,6 +22,14 @@ import type { WorkletRuntime } from './runtimes';
 
 declare global {
   var _REANIMATED_IS_REDUCED_MOTION: boolean | undefined;
+  var _getShareableAllocatorStats:
+    | (() => {
+        liveNodes: number;
+        liveBytes: number;
+        highWaterBytes: number;
+        pooledBytes: number;
+      })
+    | undefined;
   var _IS_FABRIC: boolean | undefined;
   var _REANIMATED_VERSION_CPP: string | undefined;
   var _REANIMATED_VERSION_JS: string | undefined;
@@ -32,6 +40,9 @@ declare global {
     | ((js: string, sourceURL: string, sourceMap: string) => any)
     | undefined;
   var evalWithSourceUrl: ((js: string, sourceURL: string) => any) | undefined;
+  var _evalWithWorkletHash:
+    | ((js: string, workletHash: number) => any)
+    | undefined;
   var _log: (value: unknown) => void;
   var _toString: (value: unknown) => string;
   var _notifyAboutProgress: (
@@ -41,14 +52,25 @@ declare global {
   ) => void;
   var _notifyAboutEnd: (tag: number, removeView: boolean) => void;
   var _setGestureState: (handlerTag: number, newState: number) => void;
-  var _makeShareableClone: <T>(value: T) => FlatShareableRef<T>;
+  var _requestDeferrableAnimationFrame: (
+    callback: (timestamp: number) => void
+  ) => void;
+  var requestDeferrableAnimationFrame: (
+    callback: (timestamp: number) => void
+  ) => number;
+  var _makeShareableClone: <T>(
+    value: T,
+    isTypedArray?: boolean
+  ) => FlatShareableRef<T>;
   var _scheduleOnJS: (
     fun: __ComplexWorkletFunction<A, R>,
-    args?: unknown[]
+    args: unknown[] | undefined,
+    coalesce: boolean
   ) => void;
   var _scheduleOnRuntime: (
     runtime: WorkletRuntime,
-    worklet: ShareableRef<() => void>
+    worklet: ShareableRef<() => void>,
+    mergeKey: number | undefined
   ) => void;
   var _updatePropsPaper:
     | ((
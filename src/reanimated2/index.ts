@@ -2,19 +2,37 @@
 
 import './publicGlobals';
 
-export type { WorkletRuntime } from './core';
+export type {
+  WorkletRuntime,
+  WorkletRuntimeConfig,
+  WorkletRuntimeQueueOverflowPolicy,
+  WorkletRuntimeQueueStats,
+  WorkletRuntimePool,
+  RuntimeLockStats,
+  FrameBudgetStats,
+} from './core';
 export {
   runOnJS,
   runOnUI,
   createWorkletRuntime,
   runOnRuntime,
+  runOnRuntimeAsync,
+  getUIRuntimeLockStats,
+  getFrameBudgetStats,
+  createWorkletRuntimePool,
+  runOnRuntimePool,
+  parallelForOnRuntimePool,
   makeMutable,
   makeShareableCloneRecursive,
+  makeShareableArrayBuffer,
   isReanimated3,
   isConfigured,
   enableLayoutAnimations,
+  enableShareableDeduplication,
   getViewProp,
   executeOnUIRuntimeSync,
+  runOnUIAsync,
+  requestDeferrableAnimationFrame,
 } from './core';
 export type {
   GestureHandlers,
@@ -238,6 +256,11 @@ export type {
   AnimatedKeyboardInfo,
   AnimatedKeyboardOptions,
   MeasuredDimensions,
+  ArrayBufferTransferMode,
+  UILane,
+  RunOnUIOptions,
+  ExecuteOnUIRuntimeSyncOptions,
+  RunOnJSOptions,
 } from './commonTypes';
 export {
   SensorType,
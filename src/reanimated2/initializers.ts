@@ -106,6 +106,23 @@ function setupRequestAnimationFrame() {
     // attempt to store the value returned from rAF and use it for cancelling.
     return -1;
   };
+
+  const nativeRequestDeferrableAnimationFrame =
+    global._requestDeferrableAnimationFrame;
+
+  // Deferrable callbacks run after the regular ones and only as long as the
+  // frame budget allows, otherwise they are postponed to the next frame.
+  global.requestDeferrableAnimationFrame = (
+    callback: (timestamp: number) => void
+  ): number => {
+    nativeRequestDeferrableAnimationFrame((timestamp) => {
+      global.__frameTimestamp = timestamp;
+      callback(timestamp);
+      global.__frameTimestamp = undefined;
+      callMicrotasks();
+    });
+    return -1;
+  };
 }
 
 export function initializeUIRuntime() {
@@ -9,7 +9,12 @@ import type { ShareableRef, Value3D, ValueRotation } from '../commonTypes';
 import { SensorType } from '../commonTypes';
 import type { WebSensor } from './WebSensor';
 import { mockedRequestAnimationFrame } from '../mockedRequestAnimationFrame';
-import type { WorkletRuntime } from '../runtimes';
+import type {
+  FrameBudgetStats,
+  RuntimeLockStats,
+  WorkletRuntime,
+  WorkletRuntimePool,
+} from '../runtimes';
 
 // In Node.js environments (like when static rendering with Expo Router)
 // requestAnimationFrame is unavailable, so we use our mock.
@@ -30,6 +35,10 @@ export default class JSReanimated {
     );
   }
 
+  enableShareableDeduplication() {
+    // noop
+  }
+
   scheduleOnUI<T>(worklet: ShareableRef<T>) {
     // @ts-ignore web implementation has still not been updated after the rewrite, this will be addressed once the web implementation updates are ready
     requestAnimationFrameImpl(worklet);
@@ -44,12 +53,32 @@ export default class JSReanimated {
     );
   }
 
+  createWorkletRuntimePool(): WorkletRuntimePool {
+    throw new Error(
+      '[Reanimated] createWorkletRuntimePool is not available in JSReanimated.'
+    );
+  }
+
   scheduleOnRuntime() {
     throw new Error(
       '[Reanimated] scheduleOnRuntime is not available in JSReanimated.'
     );
   }
 
+  runOnRuntimeAsync<T, R>(
+    workletRuntime: WorkletRuntime | undefined,
+    worklet: ShareableRef<T>
+  ): Promise<R> {
+    if (workletRuntime !== undefined) {
+      throw new Error(
+        '[Reanimated] runOnRuntimeAsync is not available in JSReanimated.'
+      );
+    }
+    // There's no UI runtime on web, so `runOnUIAsync` runs the worklet on the
+    // JS thread in a microtask, the way `runOnUI` does.
+    return Promise.resolve().then(() => (worklet as unknown as () => R)());
+  }
+
   registerEventHandler<T>(
     _eventHandler: ShareableRef<T>,
     _eventName: string,
@@ -300,6 +329,18 @@ export default class JSReanimated {
       '[Reanimated] `executeOnUIRuntimeSync` is not available in JSReanimated.'
     );
   }
+
+  getUIRuntimeLockStats(): RuntimeLockStats {
+    throw new Error(
+      '[Reanimated] `getUIRuntimeLockStats` is not available in JSReanimated.'
+    );
+  }
+
+  getFrameBudgetStats(): FrameBudgetStats {
+    throw new Error(
+      '[Reanimated] `getFrameBudgetStats` is not available in JSReanimated.'
+    );
+  }
 }
 
 enum Platform {
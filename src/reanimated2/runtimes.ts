@@ -1,5 +1,9 @@
 'use strict';
-import type { __ComplexWorkletFunction, WorkletFunction } from './commonTypes';
+import type {
+  __ComplexWorkletFunction,
+  ShareableRef,
+  WorkletFunction,
+} from './commonTypes';
 import { setupCallGuard, setupConsole } from './initializers';
 import NativeReanimatedModule from './NativeReanimated';
 import { shouldBeUseWeb } from './PlatformChecker';
@@ -13,6 +17,77 @@ const SHOULD_BE_USE_WEB = shouldBeUseWeb();
 export type WorkletRuntime = {
   __hostObjectWorkletRuntime: never;
   readonly name: string;
+  /**
+   * A snapshot of the queue of worklets scheduled with `runOnRuntime`.
+   */
+  readonly queueStats: WorkletRuntimeQueueStats;
+};
+
+/**
+ * Decides what happens to a worklet scheduled with `runOnRuntime` when the queue of the runtime is full.
+ *
+ * - `block` - the scheduling thread waits until the runtime catches up.
+ * - `dropOldest` - the oldest pending worklet is dropped.
+ * - `dropNewest` - the newly scheduled worklet is dropped.
+ * - `merge` - a pending call of the same worklet is replaced with the new one, even if the queue is not full. Otherwise behaves like `dropOldest`. Calls are merged only if they were scheduled on the JS thread with the very same worklet function, as worklets with the same code may capture different values. Calls scheduled from other runtimes are never merged.
+ *
+ * With `block`, a worklet that schedules another one on its own runtime is never blocked, instead the queue grows past its capacity.
+ */
+export type WorkletRuntimeQueueOverflowPolicy =
+  | 'block'
+  | 'dropOldest'
+  | 'dropNewest'
+  | 'merge';
+
+export type WorkletRuntimeConfig = {
+  /**
+   * The maximum number of pending worklets, unbounded by default.
+   */
+  queueCapacity?: number;
+  /**
+   * Defaults to `block`.
+   */
+  queueOverflowPolicy?: WorkletRuntimeQueueOverflowPolicy;
+  /**
+   * The initial size of the heap in bytes, less than 4 GiB, uses the engine default if not set. Hermes only.
+   */
+  initialHeapSize?: number;
+  /**
+   * The maximum size of the heap in bytes, less than 4 GiB, uses the engine default if not set. Hermes only.
+   */
+  maxHeapSize?: number;
+  /**
+   * Hermes only, defaults to `default`.
+   *
+   * - `compact` - returns unused memory to the system after every collection, for short-lived runtimes that should stay small.
+   * - `lowLatency` - never spends time on returning unused memory to the system, which keeps collections short.
+   */
+  gcMode?: 'default' | 'compact' | 'lowLatency';
+  /**
+   * Enables the native microtask queue (`queueMicrotask` and promise jobs), which is drained after every scheduled worklet. Hermes only, requires React Native 0.71 or newer, defaults to `false`.
+   */
+  enableMicrotasks?: boolean;
+  /**
+   * Whether the runtime can be debugged with Chrome DevTools in debug builds. Hermes only, defaults to `true`.
+   */
+  enableDebugger?: boolean;
+  /**
+   * Whether the runtime evaluates the precompiled worklet bundle of the app (`worklets.hbc`, see `scripts/build-worklet-bundle.js`) when it's created. Defaults to `false`, the UI runtime always does.
+   */
+  usePrecompiledWorklets?: boolean;
+};
+
+export type WorkletRuntimeQueueStats = {
+  depth: number;
+  maxDepth: number;
+  // 0 if the queue is unbounded
+  capacity: number;
+  processed: number;
+  dropped: number;
+  merged: number;
+  // time between scheduling a worklet and the start of its execution
+  lastLatencyMs: number;
+  averageLatencyMs: number;
 };
 
 /**
@@ -20,12 +95,14 @@ export type WorkletRuntime = {
  *
  * @param name - A name used to identify the runtime which will appear in devices list in Chrome DevTools.
  * @param initializer - An optional worklet that will be run synchronously on the same thread immediately after the runtime is created.
+ * @param config - An optional object that configures the queue of worklets scheduled with `runOnRuntime` and the engine of the runtime - {@link WorkletRuntimeConfig}
  * @returns WorkletRuntime which is a jsi::HostObject\<reanimated::WorkletRuntime\> - {@link WorkletRuntime}
  * @see https://docs.swmansion.com/react-native-reanimated/docs/threading/createWorkletRuntime
  */
 export function createWorkletRuntime(
   name: string,
-  initializer?: __ComplexWorkletFunction<[], void>
+  initializer?: __ComplexWorkletFunction<[], void>,
+  config?: WorkletRuntimeConfig
 ) {
   return NativeReanimatedModule.createWorkletRuntime(
     name,
@@ -34,7 +111,8 @@ export function createWorkletRuntime(
       setupCallGuard();
       setupConsole();
       initializer?.();
-    })
+    }),
+    config
   );
 }
 
@@ -66,7 +144,8 @@ export function runOnRuntime<Args extends unknown[], ReturnValue>(
         makeShareableCloneOnUIRecursive(() => {
           'worklet';
           worklet(...args);
-        })
+        }),
+        undefined
       );
   }
   return (...args) =>
@@ -75,6 +154,174 @@ export function runOnRuntime<Args extends unknown[], ReturnValue>(
       makeShareableCloneRecursive(() => {
         'worklet';
         worklet(...args);
+      }),
+      // calls of the same worklet can be merged, see `merge` in
+      // `WorkletRuntimeQueueOverflowPolicy`
+      worklet
+    );
+}
+
+/**
+ * Schedule a worklet to execute on the background queue and get its result back on the JS thread without blocking it.
+ *
+ * @returns A function that calls the worklet with the given arguments and returns a Promise which resolves with a copy of the value returned by the worklet, or rejects with the error it throws.
+ */
+export function runOnRuntimeAsync<Args extends unknown[], ReturnValue>(
+  workletRuntime: WorkletRuntime,
+  worklet: (...args: Args) => ReturnValue
+): (...args: Args) => Promise<ReturnValue> {
+  if (__DEV__ && (worklet as WorkletFunction).__workletHash === undefined) {
+    throw new Error(
+      '[Reanimated] The function passed to `runOnRuntimeAsync` is not a worklet.'
+    );
+  }
+  return (...args) =>
+    NativeReanimatedModule.runOnRuntimeAsync(
+      workletRuntime,
+      makeShareableCloneRecursive(() => {
+        'worklet';
+        return makeShareableCloneOnUIRecursive(worklet(...args));
+      })
+    );
+}
+
+/**
+ * Contention statistics of the lock that guards the UI runtime against `executeOnUIRuntimeSync` calls from the JS thread.
+ *
+ * - `acquisitions` - the number of times the lock was taken, not counting recursive acquisitions.
+ * - `contendedAcquisitions` - how many of them had to wait for another thread.
+ * - `totalWaitMs` - the time spent waiting in contended acquisitions.
+ * - `longestHoldMs` - the longest time the lock was held.
+ */
+export type RuntimeLockStats = {
+  acquisitions: number;
+  contendedAcquisitions: number;
+  totalWaitMs: number;
+  longestHoldMs: number;
+};
+
+/**
+ * Returns a snapshot of the {@link RuntimeLockStats} of the UI runtime.
+ */
+export function getUIRuntimeLockStats(): RuntimeLockStats {
+  return NativeReanimatedModule.getUIRuntimeLockStats();
+}
+
+/**
+ * Statistics of the frames in which the UI runtime ran `requestAnimationFrame` callbacks.
+ *
+ * - `frames` - the number of such frames.
+ * - `overBudgetFrames` - how many of them took longer than the budget.
+ * - `deferredCallbacks` - how many times a callback requested with `requestDeferrableAnimationFrame` was postponed to the next frame.
+ * - `budgetMs` - the time the callbacks of the last frame were allowed to take.
+ * - `frameIntervalMs` - the frame interval of the display, as observed in the last frame.
+ * - `longestFrameMs` - the longest time the callbacks of a single frame took.
+ */
+export type FrameBudgetStats = {
+  frames: number;
+  overBudgetFrames: number;
+  deferredCallbacks: number;
+  budgetMs: number;
+  frameIntervalMs: number;
+  longestFrameMs: number;
+};
+
+/**
+ * Returns a snapshot of the {@link FrameBudgetStats} of the UI runtime.
+ */
+export function getFrameBudgetStats(): FrameBudgetStats {
+  return NativeReanimatedModule.getFrameBudgetStats();
+}
+
+export type WorkletRuntimePool = {
+  __hostObjectWorkletRuntimePool: never;
+  readonly name: string;
+  readonly size: number;
+};
+
+/**
+ * Lets you create a pool of JS runtimes, each running on its own thread, that share a work-stealing scheduler. Use it to spread CPU-heavy worklets across multiple cores.
+ *
+ * @param name - A name used to identify the runtimes of the pool, followed by their index.
+ * @param size - An optional number of runtimes in the pool. Defaults to the number of cores minus two, leaving room for the JS and UI threads.
+ * @param initializer - An optional worklet that will be run synchronously on each of the runtimes immediately after it is created.
+ * @returns WorkletRuntimePool which is a jsi::HostObject\<reanimated::WorkletRuntimePool\> - {@link WorkletRuntimePool}
+ */
+export function createWorkletRuntimePool(
+  name: string,
+  size?: number,
+  initializer?: __ComplexWorkletFunction<[], void>
+): WorkletRuntimePool {
+  return NativeReanimatedModule.createWorkletRuntimePool(
+    name,
+    size,
+    makeShareableCloneRecursive(() => {
+      'worklet';
+      setupCallGuard();
+      setupConsole();
+      initializer?.();
+    })
+  );
+}
+
+type WorkletRuntimePoolMethods = {
+  schedule: (worklet: ShareableRef<() => void>) => void;
+  parallelFor: (
+    count: number,
+    worklet: ShareableRef<(index: number) => void>,
+    onComplete?: () => void
+  ) => void;
+};
+
+// @ts-expect-error Check `runOnUI` overload.
+export function runOnRuntimePool<Args extends unknown[], ReturnValue>(
+  pool: WorkletRuntimePool,
+  worklet: (...args: Args) => ReturnValue
+): WorkletFunction<Args, ReturnValue>;
+/**
+ * Schedule a worklet to execute on any of the runtimes of the pool.
+ */
+export function runOnRuntimePool<Args extends unknown[], ReturnValue>(
+  pool: WorkletRuntimePool,
+  worklet: WorkletFunction<Args, ReturnValue>
+): (...args: Args) => void {
+  'worklet';
+  if (__DEV__ && !SHOULD_BE_USE_WEB && worklet.__workletHash === undefined) {
+    throw new Error(
+      '[Reanimated] The function passed to `runOnRuntimePool` is not a worklet.'
+    );
+  }
+  const makeShareableClone = _WORKLET
+    ? makeShareableCloneOnUIRecursive
+    : makeShareableCloneRecursive;
+  return (...args) =>
+    (pool as unknown as WorkletRuntimePoolMethods).schedule(
+      makeShareableClone(() => {
+        'worklet';
+        worklet(...args);
       })
     );
 }
+
+/**
+ * Calls a worklet with every index from 0 to `count - 1`, spreading the calls across the runtimes of the pool.
+ *
+ * @param onComplete - An optional function called on the JS thread once all the calls are done.
+ */
+export function parallelForOnRuntimePool(
+  pool: WorkletRuntimePool,
+  count: number,
+  worklet: (index: number) => void,
+  onComplete?: () => void
+): void {
+  if (__DEV__ && (worklet as WorkletFunction).__workletHash === undefined) {
+    throw new Error(
+      '[Reanimated] The function passed to `parallelForOnRuntimePool` is not a worklet.'
+    );
+  }
+  (pool as unknown as WorkletRuntimePoolMethods).parallelFor(
+    count,
+    makeShareableCloneRecursive(worklet),
+    onComplete
+  );
+}
@@ -1,6 +1,7 @@
 'use strict';
 import NativeReanimatedModule from './NativeReanimated';
 import type {
+  ArrayBufferTransferMode,
   ShareableRef,
   FlatShareableRef,
   __WorkletFunction,
@@ -30,6 +31,11 @@ function isHostObject(value: NonNullable<object>) {
   return MAGIC_KEY in value;
 }
 
+function isTypedArray(value: object): value is ArrayBufferView {
+  'worklet';
+  return ArrayBuffer.isView(value) && !(value instanceof DataView);
+}
+
 function isPlainJSObject(object: object): object is object {
   return Object.getPrototypeOf(object) === Object.prototype;
 }
@@ -98,6 +104,64 @@ const DETECT_CYCLIC_OBJECT_DEPTH_THRESHOLD = 30;
 // We use it to check if later on the function reenters with the same object
 let processedObjectAtThresholdDepth: unknown;
 
+// Results of isPlainDataTree for the objects visited during the current
+// top-level call of makeShareableCloneRecursive, so that the subtrees of an
+// object which turned out not to be plain data aren't scanned again when we
+// recurse into them.
+let plainDataTreeResults = new WeakMap<object, boolean>();
+
+function isPlainDataElement(element: unknown, depth: number): boolean {
+  const type = typeof element;
+  if (type === 'object') {
+    return element === null || isPlainDataTree(element as object, depth + 1);
+  }
+  return (
+    type === 'number' ||
+    type === 'string' ||
+    type === 'boolean' ||
+    type === 'undefined'
+  );
+}
+
+// Tells whether the value is a tree of plain objects, arrays and primitives
+// only. Such trees are packed natively in a single walk instead of making a
+// shareable for every nested object. Objects that already have a shareable
+// are left out so that we reuse it.
+function isPlainDataTree(value: object, depth: number): boolean {
+  const result = plainDataTreeResults.get(value);
+  if (result !== undefined) {
+    return result;
+  }
+  // cycles are not plain data, they are reported by makeShareableCloneRecursive
+  plainDataTreeResults.set(value, false);
+  if (
+    depth >= DETECT_CYCLIC_OBJECT_DEPTH_THRESHOLD ||
+    shareableMappingCache.get(value) !== undefined ||
+    isHostObject(value)
+  ) {
+    return false;
+  }
+  let isPlainData = false;
+  if (Array.isArray(value)) {
+    isPlainData = value.every((element) => isPlainDataElement(element, depth));
+  } else if (isPlainJSObject(value)) {
+    isPlainData = Object.values(value).every((element) =>
+      isPlainDataElement(element, depth)
+    );
+  }
+  plainDataTreeResults.set(value, isPlainData);
+  return isPlainData;
+}
+
+function freezePlainDataTree(value: object) {
+  Object.freeze(value);
+  for (const element of Object.values(value)) {
+    if (typeof element === 'object' && element !== null) {
+      freezePlainDataTree(element);
+    }
+  }
+}
+
 export function makeShareableCloneRecursive<T>(
   value: any,
   shouldPersistRemote = false,
@@ -134,7 +198,16 @@ export function makeShareableCloneRecursive<T>(
       return cached as ShareableRef<T>;
     } else {
       let toAdapt: any;
-      if (Array.isArray(value)) {
+      let isTypedArrayValue = false;
+      let isPlainDataValue = false;
+      if (depth === 0) {
+        plainDataTreeResults = new WeakMap();
+      }
+      if (!shouldPersistRemote && isPlainDataTree(value, depth)) {
+        // packed natively as a whole, retained values are never packed
+        toAdapt = value;
+        isPlainDataValue = true;
+      } else if (Array.isArray(value)) {
         toAdapt = value.map((element) =>
           makeShareableCloneRecursive(element, shouldPersistRemote, depth + 1)
         );
@@ -204,8 +277,15 @@ Offending code was: \`${getWorkletCode(value)}\``);
         return handle as ShareableRef<T>;
       } else if (value instanceof ArrayBuffer) {
         toAdapt = value;
+      } else if (isTypedArray(value)) {
+        // typed arrays (e.g. Float32Array) are copied natively along with the
+        // visible part of their buffer, JSI can't tell them apart from other
+        // objects on its own. Other transfer modes are set up with
+        // `makeShareableArrayBuffer`, which caches the shareable up front.
+        toAdapt = value;
+        isTypedArrayValue = true;
       } else if (ArrayBuffer.isView(value)) {
-        // typed array (e.g. Int32Array, Uint8ClampedArray) or DataView
+        // DataView
         const buffer = value.buffer;
         const typeName = value.constructor.name;
         const handle = makeShareableCloneRecursive({
@@ -241,7 +321,10 @@ Offending code was: \`${getWorkletCode(value)}\``);
         shareableMappingCache.set(value, inaccessibleObject);
         return inaccessibleObject;
       }
-      if (__DEV__) {
+      // Typed arrays with elements can't be frozen.
+      if (__DEV__ && isPlainDataValue) {
+        freezePlainDataTree(value);
+      } else if (__DEV__ && !isTypedArrayValue) {
         // we freeze objects that are transformed to shareable. This should help
         // detect issues when someone modifies data after it's been converted to
         // shareable. Meaning that they may be doing a faulty assumption in their
@@ -252,7 +335,10 @@ Offending code was: \`${getWorkletCode(value)}\``);
       }
       const adopted = NativeReanimatedModule.makeShareableClone(
         toAdapt,
-        shouldPersistRemote
+        shouldPersistRemote,
+        undefined,
+        isTypedArrayValue,
+        isPlainDataValue
       );
       shareableMappingCache.set(value, adopted);
       shareableMappingCache.set(adopted);
@@ -318,6 +404,13 @@ export function makeShareableCloneOnUIRecursive<T>(
           value.map(cloneRecursive)
         ) as FlatShareableRef<T>;
       }
+      if (value instanceof ArrayBuffer) {
+        return _makeShareableClone(value) as FlatShareableRef<T>;
+      }
+      if (isTypedArray(value)) {
+        // Copied natively as a whole, like array buffers.
+        return _makeShareableClone(value, true) as FlatShareableRef<T>;
+      }
       const toAdapt: Record<string, FlatShareableRef<T>> = {};
       for (const [key, element] of Object.entries(value)) {
         toAdapt[key] = cloneRecursive(element);
@@ -355,3 +448,46 @@ function makeShareableNative<T extends object>(value: T): T {
 export const makeShareable = SHOULD_BE_USE_WEB
   ? makeShareableJS
   : makeShareableNative;
+
+function makeShareableArrayBufferJS<T extends ArrayBuffer | ArrayBufferView>(
+  buffer: T
+): T {
+  return buffer;
+}
+
+function makeShareableArrayBufferNative<
+  T extends ArrayBuffer | ArrayBufferView
+>(buffer: T, mode: ArrayBufferTransferMode): T {
+  if (shareableMappingCache.get(buffer)) {
+    return buffer;
+  }
+  const isTypedArrayValue = ArrayBuffer.isView(buffer);
+  if (isTypedArrayValue && !isTypedArray(buffer)) {
+    throw new Error(
+      '[Reanimated] `makeShareableArrayBuffer` does not support DataView, pass its buffer instead.'
+    );
+  }
+  const handle = NativeReanimatedModule.makeShareableClone(
+    buffer,
+    false,
+    mode,
+    isTypedArrayValue
+  );
+  shareableMappingCache.set(buffer, handle);
+  return buffer;
+}
+
+/**
+ * This function decides how the contents of the given ArrayBuffer or typed
+ * array (e.g. Float32Array) are passed to other runtimes when it gets captured
+ * by a worklet. By default every runtime receives its own copy of the data.
+ * With `'share'` all runtimes receive buffers backed by the same native memory
+ * which then must not be modified. With `'transfer'` the first runtime that
+ * receives the buffer takes over its memory and any further attempt to pass
+ * the buffer to a runtime throws. For typed arrays only the part of the buffer
+ * visible through the array is passed. Note that the data is still copied
+ * once, at the time of calling this function.
+ */
+export const makeShareableArrayBuffer = SHOULD_BE_USE_WEB
+  ? makeShareableArrayBufferJS
+  : makeShareableArrayBufferNative;
@@ -1,7 +1,13 @@
 'use strict';
 import NativeReanimatedModule from './NativeReanimated';
 import { isJest, shouldBeUseWeb } from './PlatformChecker';
-import type { WorkletFunction } from './commonTypes';
+import type {
+  ExecuteOnUIRuntimeSyncOptions,
+  RunOnJSOptions,
+  RunOnUIOptions,
+  UILane,
+  WorkletFunction,
+} from './commonTypes';
 import {
   makeShareableCloneOnUIRecursive,
   makeShareableCloneRecursive,
@@ -11,9 +17,12 @@ const IS_JEST = isJest();
 const SHOULD_BE_USE_WEB = shouldBeUseWeb();
 
 /**
- * An array of [worklet, args] pairs.
+ * Arrays of [worklet, args] pairs, separately for each lane.
  * */
-let _runOnUIQueue: Array<[WorkletFunction<unknown[], unknown>, unknown[]]> = [];
+const _runOnUIQueues: Record<
+  UILane,
+  Array<[WorkletFunction<unknown[], unknown>, unknown[]]>
+> = { urgent: [], deferrable: [] };
 
 export function setupMicrotasks() {
   'worklet';
@@ -61,17 +70,20 @@ export const callMicrotasks = SHOULD_BE_USE_WEB
  * at once making sure they will run within the same frame boundaries on the UI thread.
  *
  * @param fun - A reference to a function you want to execute on the [UI thread](https://docs.swmansion.com/react-native-reanimated/docs/threading/runOnUI) from the [JavaScript thread](https://docs.swmansion.com/react-native-reanimated/docs/threading/runOnUI).
+ * @param options - An optional object. Pass `{ lane: 'deferrable' }` for work that isn't time-critical, e.g. bookkeeping. Deferrable worklets run only after urgent ones, when the UI thread has time to spare.
  * @returns A function that accepts arguments for the function passed as the first argument.
  * @see https://docs.swmansion.com/react-native-reanimated/docs/threading/runOnUI
  */
 // @ts-expect-error This overload is correct since it's what user sees in his code
 // before it's transformed by Reanimated Babel plugin.
 export function runOnUI<Args extends unknown[], ReturnValue>(
-  worklet: (...args: Args) => ReturnValue
+  worklet: (...args: Args) => ReturnValue,
+  options?: RunOnUIOptions
 ): (...args: Args) => void;
 
 export function runOnUI<Args extends unknown[], ReturnValue>(
-  worklet: WorkletFunction<Args, ReturnValue>
+  worklet: WorkletFunction<Args, ReturnValue>,
+  options?: RunOnUIOptions
 ): (...args: Args) => void {
   'worklet';
   if (__DEV__ && !SHOULD_BE_USE_WEB && _WORKLET) {
@@ -82,6 +94,7 @@ export function runOnUI<Args extends unknown[], ReturnValue>(
   if (__DEV__ && !SHOULD_BE_USE_WEB && worklet.__workletHash === undefined) {
     throw new Error('[Reanimated] `runOnUI` can only be used on worklets.');
   }
+  const lane = options?.lane ?? 'urgent';
   return (...args) => {
     if (IS_JEST) {
       // Mocking time in Jest is tricky as both requestAnimationFrame and queueMicrotask
@@ -97,7 +110,8 @@ export function runOnUI<Args extends unknown[], ReturnValue>(
         makeShareableCloneRecursive(() => {
           'worklet';
           worklet(...args);
-        })
+        }),
+        lane
       );
       return;
     }
@@ -111,11 +125,14 @@ export function runOnUI<Args extends unknown[], ReturnValue>(
       makeShareableCloneRecursive(args);
     }
     //
-    _runOnUIQueue.push([worklet as WorkletFunction<unknown[], unknown>, args]);
-    if (_runOnUIQueue.length === 1) {
+    _runOnUIQueues[lane].push([
+      worklet as WorkletFunction<unknown[], unknown>,
+      args,
+    ]);
+    if (_runOnUIQueues[lane].length === 1) {
       queueMicrotask(() => {
-        const queue = _runOnUIQueue;
-        _runOnUIQueue = [];
+        const queue = _runOnUIQueues[lane];
+        _runOnUIQueues[lane] = [];
         NativeReanimatedModule.scheduleOnUI(
           makeShareableCloneRecursive(() => {
             'worklet';
@@ -124,7 +141,8 @@ export function runOnUI<Args extends unknown[], ReturnValue>(
               worklet(...args);
             });
             callMicrotasks();
-          })
+          }),
+          lane
         );
       });
     }
@@ -136,20 +154,83 @@ export function executeOnUIRuntimeSync<Args extends unknown[], ReturnValue>(
   worklet: (...args: Args) => ReturnValue
 ): (...args: Args) => ReturnValue;
 
+// @ts-expect-error Check `executeOnUIRuntimeSync` overload above.
 export function executeOnUIRuntimeSync<Args extends unknown[], ReturnValue>(
-  worklet: WorkletFunction<Args, ReturnValue>
-): (...args: Args) => ReturnValue {
+  worklet: (...args: Args) => ReturnValue,
+  options: ExecuteOnUIRuntimeSyncOptions
+): (...args: Args) => ReturnValue | undefined;
+
+export function executeOnUIRuntimeSync<Args extends unknown[], ReturnValue>(
+  worklet: WorkletFunction<Args, ReturnValue>,
+  options?: ExecuteOnUIRuntimeSyncOptions
+): (...args: Args) => ReturnValue | undefined {
   return (...args) => {
     return NativeReanimatedModule.executeOnUIRuntimeSync(
       makeShareableCloneRecursive(() => {
         'worklet';
         const result = worklet(...args);
         return makeShareableCloneOnUIRecursive(result);
-      })
+      }),
+      options
     );
   };
 }
 
+/**
+ * Like `executeOnUIRuntimeSync`, but doesn't block the JS thread while the UI thread is busy.
+ *
+ * @returns A function that calls the worklet on the UI runtime with the given arguments and returns a Promise which resolves with a copy of the value returned by the worklet, or rejects with the error it throws.
+ */
+export function runOnUIAsync<Args extends unknown[], ReturnValue>(
+  worklet: (...args: Args) => ReturnValue
+): (...args: Args) => Promise<ReturnValue> {
+  if (__DEV__ && !SHOULD_BE_USE_WEB && _WORKLET) {
+    throw new Error(
+      '[Reanimated] `runOnUIAsync` cannot be called on the UI runtime.'
+    );
+  }
+  if (
+    __DEV__ &&
+    !SHOULD_BE_USE_WEB &&
+    (worklet as WorkletFunction).__workletHash === undefined
+  ) {
+    throw new Error('[Reanimated] `runOnUIAsync` can only be used on worklets.');
+  }
+  return (...args) =>
+    NativeReanimatedModule.runOnRuntimeAsync(
+      undefined,
+      makeShareableCloneRecursive(() => {
+        'worklet';
+        return makeShareableCloneOnUIRecursive(worklet(...args));
+      })
+    );
+}
+
+/**
+ * Lets you request a callback for the next frame on the UI thread that runs only when the frame has time to spare. Use it instead of `requestAnimationFrame` for work that isn't time-critical, e.g. bookkeeping.
+ *
+ * Deferrable callbacks run after the ones requested with `requestAnimationFrame`. When the remaining frame budget doesn't fit them, they are postponed to the next frame, ahead of newly requested ones. At least one of them runs in every frame. On the Web it falls back to `requestAnimationFrame`.
+ *
+ * @param callback - A function called with the timestamp of the frame it runs in.
+ * @returns -1, as the callbacks can't be cancelled.
+ * @see https://docs.swmansion.com/react-native-reanimated/docs/threading/requestDeferrableAnimationFrame
+ */
+export function requestDeferrableAnimationFrame(
+  callback: (timestamp: number) => void
+): number {
+  'worklet';
+  if (SHOULD_BE_USE_WEB) {
+    requestAnimationFrame(callback);
+    return -1;
+  }
+  if (global.requestDeferrableAnimationFrame === undefined) {
+    throw new Error(
+      '[Reanimated] `requestDeferrableAnimationFrame` can only be called on the UI runtime.'
+    );
+  }
+  return global.requestDeferrableAnimationFrame(callback);
+}
+
 // @ts-expect-error Check `runOnUI` overload above.
 export function runOnUIImmediately<Args extends unknown[], ReturnValue>(
   worklet: (...args: Args) => ReturnValue
@@ -201,11 +282,27 @@ function runWorkletOnJS<Args extends unknown[], ReturnValue>(
   worklet(...args);
 }
 
+function cloneRemoteCallArg(arg: unknown): unknown {
+  'worklet';
+  // Primitives are copied natively as they are, without creating a shareable.
+  if (
+    arg === undefined ||
+    arg === null ||
+    typeof arg === 'boolean' ||
+    typeof arg === 'number' ||
+    typeof arg === 'string'
+  ) {
+    return arg;
+  }
+  return makeShareableCloneOnUIRecursive(arg);
+}
+
 /**
  * Lets you asynchronously run non-[workletized](https://docs.swmansion.com/react-native-reanimated/docs/fundamentals/glossary#to-workletize) functions that couldn't otherwise run on the [UI thread](https://docs.swmansion.com/react-native-reanimated/docs/fundamentals/glossary#ui-thread).
  * This applies to most external libraries as they don't have their functions marked with "worklet"; directive.
  *
  * @param fun - A reference to a function you want to execute on the JavaScript thread from the UI thread.
+ * @param options - An optional object. Pass `{ coalesce: true }` to drop calls that are superseded by a newer call of the same function before they reach the JavaScript thread, e.g. when updating state on every frame. Ignored when `fun` is a worklet.
  * @returns A function that accepts arguments for the function passed as the first argument.
  * @see https://docs.swmansion.com/react-native-reanimated/docs/threading/runOnJS
  */
@@ -213,7 +310,8 @@ export function runOnJS<Args extends unknown[], ReturnValue>(
   fun:
     | ((...args: Args) => ReturnValue)
     | RemoteFunction<Args, ReturnValue>
-    | WorkletFunction<Args, ReturnValue>
+    | WorkletFunction<Args, ReturnValue>,
+  options?: RunOnJSOptions
 ): (...args: Args) => void {
   'worklet';
   type FunWorklet = Extract<typeof fun, WorkletFunction<Args, ReturnValue>>;
@@ -244,15 +342,14 @@ export function runOnJS<Args extends unknown[], ReturnValue>(
     // reference to the original remote function in the `__functionInDEV` property.
     fun = (fun as FunDevRemote).__remoteFunction;
   }
+  const coalesce = options?.coalesce ?? false;
   return (...args) => {
     _scheduleOnJS(
       fun as
         | ((...args: Args) => ReturnValue)
         | WorkletFunction<Args, ReturnValue>,
-      args.length > 0
-        ? // TODO TYPESCRIPT this cast is terrible but will be fixed
-          (makeShareableCloneOnUIRecursive(args) as unknown as unknown[])
-        : undefined
+      args.length > 0 ? args.map(cloneRemoteCallArg) : undefined,
+      coalesce
     );
   };
 }
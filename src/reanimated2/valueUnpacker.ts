@@ -35,6 +35,13 @@ function valueUnpacker(objectToUnpack: any, category?: string): any {
           '(' + initData.code + '\n)',
           `worklet_${workletHash}`
         ) as (...args: any[]) => any;
+      } else if (global._evalWithWorkletHash) {
+        // in release on worklet runtimes the code is compiled once per process
+        // and shared between all the runtimes
+        workletFun = global._evalWithWorkletHash(
+          '(' + initData.code + '\n)',
+          workletHash
+        ) as (...args: any[]) => any;
       } else {
         // in release we use the regular eval to save on JSI calls
         // eslint-disable-next-line no-eval